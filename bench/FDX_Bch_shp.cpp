@@ -0,0 +1,129 @@
+/*
+ * FDX_Bch_shp.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Bch_shp
+    Benchmark of the contact, TTH and movement kernels of the shapes through the generic interface
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Shapes
+#include "../include/FDX_Geo.hpp"
+
+//Timing
+#include <chrono>
+
+//Report
+#include <cstdio>
+
+//Random shapes
+#include <random>
+#include <vector>
+#include <memory>
+
+using namespace fdx::arrow;
+
+/*
+    Configuration
+*/
+
+//Number of shapes, half circles and half rectangles
+constexpr std::size_t SHAPES=2048;
+
+//Pairs tested for each shape
+constexpr std::size_t PAIRS=256;
+
+//Runs of each kernel, the best one is reported
+constexpr int RUNS=15;
+
+/*
+    Benchmark
+*/
+
+//Run a kernel over every pair and report the best time, the sum of the results keeps the calls from being removed
+template <class F>
+void run (const char *name, const std::vector<std::unique_ptr<Shp>> &shapes, const std::vector<Vct> &speeds, F f)
+{
+    double best=0, sum=0;
+    for (int r=0;r<RUNS;r++)
+    {
+        sum=0;
+        auto begin=std::chrono::steady_clock::now();
+        for (std::size_t i=0;i<SHAPES;i++)
+            for (std::size_t j=0;j<PAIRS;j++)
+                sum+=f(*shapes[i],*shapes[(i*7+j*13+1)%SHAPES],speeds[(i+j)%SHAPES]);
+        double ms=std::chrono::duration<double,std::milli>(std::chrono::steady_clock::now()-begin).count();
+        if (!r||ms<best)
+            best=ms;
+    }
+    std::printf("%-12s %9.3f ms %7.2f ns/call (sum %g)\n",name,best,best*1e6/(SHAPES*PAIRS),sum);
+}
+
+int main()
+{
+    //Circles and rectangles, with random speeds
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<double> pos(-50,50), size(0.5,4);
+    std::vector<std::unique_ptr<Shp>> shapes;
+    std::vector<Vct> speeds;
+    for (std::size_t i=0;i<SHAPES;i++)
+    {
+        if (i%2)
+            shapes.emplace_back(new Rct(Vct(pos(gen),pos(gen)),Vct(size(gen),size(gen))));
+        else
+            shapes.emplace_back(new Crl(Vct(pos(gen),pos(gen)),size(gen)));
+    }
+    for (std::size_t i=0;i<SHAPES;i++)
+        speeds.push_back(Vct(pos(gen)*0.2,pos(gen)*0.2));
+
+    //Kernels
+    run("contact",shapes,speeds,[](const Shp &a, const Shp &b, const Vct &)
+    {
+        return a.contact(b)?1.0:0.0;
+    });
+    run("tth",shapes,speeds,[](const Shp &a, const Shp &b, const Vct &v)
+    {
+        return a.tth(b,v);
+    });
+    run("toi",shapes,speeds,[](const Shp &a, const Shp &b, const Vct &v)
+    {
+        return a.toi(b,v).t;
+    });
+    run("mov_against",shapes,speeds,[](const Shp &a, const Shp &b, const Vct &v)
+    {
+        Vct m(a.mov_against(b,v));
+        return m.x+m.y;
+    });
+
+    return 0;
+}
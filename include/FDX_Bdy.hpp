@@ -0,0 +1,317 @@
+/*
+ * FDX_Bdy.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Bdy
+    Store of bodies in columns (SoA) addressed by generational handles
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_BDY_H_
+#define _FDX_BDY_H_
+
+
+/* Includes */
+
+//Shapes
+#include "FDX_Geo.hpp"
+
+//Arrays of vectors
+#include "FDX_Vca.hpp"
+
+//Fixed size integers
+#include <cstdint>
+
+//Columns
+#include <vector>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    //Handle of a body, the generation makes handles of removed bodies invalid even if their slot is reused
+    struct Bdy_hdl
+    {
+        std::uint32_t index;//Slot of the body
+        std::uint32_t gen;//Generation of the slot when the body was added
+
+        //Equality operator
+        bool operator== (const Bdy_hdl &h) const
+        {
+            return index==h.index&&gen==h.gen;
+        }
+
+        //Inequality operator
+        bool operator!= (const Bdy_hdl &h) const
+        {
+            return !(*this==h);
+        }
+    };
+
+    //Temporary shapes used to call the per pair functions with the data of a body
+    struct Shp_buf
+    {
+        Crl crl;
+        Pnt pnt;
+        Rct rct;
+        Obb obb;
+        Cap cap;
+    };
+
+    /*Store of bodies
+      Every property is kept in its own contiguous column, the bodies are packed in [0,size())
+      so batch kernels can walk the columns linearly. Removing a body moves the last one to its place,
+      handles keep working because they are translated through their slot*/
+    class Bdy_store
+    {
+        /* Types and constants */
+
+        public:
+
+            //Type of the coordinates
+            typedef Vct::Coord Coord;
+
+        /* Attributes */
+
+        /*Columns (indexed by the dense index of the body)*/
+
+        private:
+
+            Vca pos;//Center of the body
+
+            Vca ext;//Half size of the body (radius for circles, 0 for points, half length and radius for capsules)
+
+            Vca axs;//Unitary X axis of the body (only oriented rectangles and capsules are rotated)
+
+            Vca spd;//Speed of the body
+
+            std::vector<Shp::Tag> tag;//Type of shape
+
+            std::vector<std::uint32_t> owner;//Slot that owns each dense index
+
+        /*Slots (indexed by the handle)*/
+
+        private:
+
+            std::vector<std::uint32_t> dense;//Dense index of each slot
+
+            std::vector<std::uint32_t> gen;//Current generation of each slot
+
+            std::vector<std::uint32_t> free_slots;//Slots without body
+
+        /* Bodies */
+
+        public:
+
+            /*Add a body with the shape and speed given, returns its handle
+              Shapes that don't fit in the columns (polygons, compounds) are kept as the rectangle that contains them, with the tag of a rectangle*/
+            Bdy_hdl add (const Shp &s, const Vct &speed=Vct());
+
+            //Add a body given by its columns (as they are returned by the properties of a body), returns its handle (polygons and compounds are tagged as rectangles)
+            Bdy_hdl add (Shp::Tag t, const Vct &center, const Vct &extent, const Vct &axis, const Vct &speed=Vct());
+
+            //Remove a body, returns false if the handle was not valid
+            bool remove (Bdy_hdl h);
+
+            //Check if a handle refers to a body in the store
+            bool valid (Bdy_hdl h) const
+            {
+                return h.index<gen.size()&&gen[h.index]==h.gen&&dense[h.index]!=NO_DENSE;
+            }
+
+            //Dense index of a body (the handle must be valid)
+            std::size_t index (Bdy_hdl h) const
+            {
+                return dense[h.index];
+            }
+
+            //Handle of the body at a dense index
+            Bdy_hdl handle (std::size_t i) const
+            {
+                return Bdy_hdl{owner[i],gen[owner[i]]};
+            }
+
+            //Number of bodies
+            std::size_t size() const
+            {
+                return pos.size();
+            }
+
+            //Remove every body (handles given before are invalidated)
+            void clear();
+
+        private:
+
+            //Dense index of a slot without body
+            static constexpr std::uint32_t NO_DENSE=~std::uint32_t(0);
+
+        /* Properties of a body */
+
+        public:
+
+            //Get the center of a body
+            Vct get_pos_center (Bdy_hdl h) const
+            {
+                return pos.get(index(h));
+            }
+
+            //Set the center of a body
+            void set_pos_center (Bdy_hdl h, const Vct &ncenter)
+            {
+                pos.set(index(h),ncenter);
+            }
+
+            //Get the half size of a body
+            Vct get_extent (Bdy_hdl h) const
+            {
+                return ext.get(index(h));
+            }
+
+            //Get the unitary X axis of a body
+            Vct get_axis (Bdy_hdl h) const
+            {
+                return axs.get(index(h));
+            }
+
+            //Get the speed of a body
+            Vct get_speed (Bdy_hdl h) const
+            {
+                return spd.get(index(h));
+            }
+
+            //Set the speed of a body
+            void set_speed (Bdy_hdl h, const Vct &nspeed)
+            {
+                spd.set(index(h),nspeed);
+            }
+
+            //Get the type of shape of a body
+            Shp::Tag get_tag (Bdy_hdl h) const
+            {
+                return tag[index(h)];
+            }
+
+        /* Columns */
+
+        public:
+
+            //Read only columns
+            const Coord* pos_x() const {return pos.x.data();}
+            const Coord* pos_y() const {return pos.y.data();}
+            const Coord* ext_x() const {return ext.x.data();}
+            const Coord* ext_y() const {return ext.y.data();}
+            const Coord* axis_x() const {return axs.x.data();}
+            const Coord* axis_y() const {return axs.y.data();}
+            const Coord* speed_x() const {return spd.x.data();}
+            const Coord* speed_y() const {return spd.y.data();}
+            const Shp::Tag* tags() const {return tag.data();}
+
+            //Writable columns (the size and type of a body can't be changed through them)
+            Coord* pos_x() {return pos.x.data();}
+            Coord* pos_y() {return pos.y.data();}
+            Coord* speed_x() {return spd.x.data();}
+            Coord* speed_y() {return spd.y.data();}
+
+            /*Columns as arrays of vectors, for the bulk operations of Vca
+              The writable arrays must keep their size*/
+            const Vca& positions() const {return pos;}
+            const Vca& speeds() const {return spd;}
+            Vca& positions() {return pos;}
+            Vca& speeds() {return spd;}
+
+        /* Adapters to the shapes */
+
+        public:
+
+            //Build the shape of the body at a dense index in the buffer, returns a reference to it
+            const Shp& shape (std::size_t i, Shp_buf &buf) const;
+
+            //Contact between two bodies
+            bool contact (Bdy_hdl a, Bdy_hdl b) const;
+
+            //Time for the first body to hit the second at the given speed
+            Vct::Mod tth (Bdy_hdl a, Bdy_hdl b, const Vct &speed) const;
+
+            //Movement of the first body against the second at the given speed
+            Vct mov_against (Bdy_hdl a, Bdy_hdl b, const Vct &speed) const;
+
+        /* Batch kernels */
+
+        public:
+
+            //Contact of n pairs of bodies given by their dense indices
+            void contact (const std::uint32_t *a, const std::uint32_t *b, std::size_t n, bool *out) const;
+
+            //TTH of n pairs of bodies given by their dense indices, using the relative speed of the columns
+            void tth (const std::uint32_t *a, const std::uint32_t *b, std::size_t n, Vct::Mod *out) const;
+
+            //Move every body by its speed multiplied by dt
+            void integrate (Vct::Mod dt);
+
+            //Write the boxes of the bodies with dense indices in [first,last), in order from out
+            void bounds (std::size_t first, std::size_t last, Box *out) const;
+
+            //Box of the body at a dense index
+            Box bounds (std::size_t i) const
+            {
+                Box b;
+                bounds(i,i+1,&b);
+                return b;
+            }
+
+            /*Box of a body given by its columns
+              Half size of the box of the rotated extent (the axis of not rotated bodies is +OX),
+              capsules grow their segment by the radius in every direction*/
+            static Box bounds (Shp::Tag t, Coord x, Coord y, Coord hx, Coord hy, Coord ax, Coord ay)
+            {
+                bool cap=t==Shp::Tag::cap;
+                Coord r=cap?hy:0, w=cap?0:hy;
+                Coord bx=std::abs(ax)*hx+std::abs(ay)*w+r;
+                Coord by=std::abs(ay)*hx+std::abs(ax)*w+r;
+                return Box(Vct(x-bx,y-by),Vct(2*bx,2*by));
+            }
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_BDY_H_
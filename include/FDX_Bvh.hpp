@@ -0,0 +1,197 @@
+/*
+ * FDX_Bvh.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Bvh
+    Bounding volume hierarchy of axis aligned boxes
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_BVH_H_
+#define _FDX_BVH_H_
+
+
+/* Includes */
+
+//Boxes
+#include "FDX_Geo.hpp"
+
+//Fixed size integers
+#include <cstdint>
+
+//Nodes
+#include <vector>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    /*Bounding volume hierarchy over a list of boxes
+      The items are the indices of the boxes given to build(). Nodes are stored in an array,
+      the two children of an inner node are consecutive and always placed after their parent*/
+    class Bvh
+    {
+        /* Types and constants */
+
+        public:
+
+            //Maximum number of items in a leaf
+            static constexpr std::uint32_t LEAF_SIZE=4;
+
+            //Node of the hierarchy
+            struct Node
+            {
+                Box box;//Box that contains every item under this node
+                std::uint32_t first;//Leaf: first item in items(), inner: index of the left child (right is first+1)
+                std::uint32_t count;//Leaf: number of items, inner: 0
+
+                //Check if the node is a leaf
+                bool leaf() const
+                {
+                    return count!=0;
+                }
+            };
+
+        /* Attributes */
+
+        private:
+
+            std::vector<Node> nodes;//Nodes, the root is the first one
+
+            std::vector<std::uint32_t> items;//Items ordered by leaf
+
+        /* Building */
+
+        public:
+
+            //Build the hierarchy over the given boxes
+            void build (const std::vector<Box> &boxes);
+
+            //Update the boxes of the nodes after the items moved (keeps the topology)
+            void refit (const std::vector<Box> &boxes);
+
+            //Remove every node
+            void clear()
+            {
+                nodes.clear();
+                items.clear();
+            }
+
+        private:
+
+            //Build the subtree of the node with the items in [first,first+count)
+            void build_node (std::uint32_t n, std::uint32_t first, std::uint32_t count, const std::vector<Box> &boxes);
+
+        /* Access */
+
+        public:
+
+            //Check if there are no nodes
+            bool empty() const
+            {
+                return nodes.empty();
+            }
+
+            //Get a node, the root is the node 0
+            const Node& node (std::uint32_t n) const
+            {
+                return nodes[n];
+            }
+
+            //Get the item at the position i of the leaf order
+            std::uint32_t item (std::uint32_t i) const
+            {
+                return items[i];
+            }
+
+            //Number of nodes
+            std::size_t size() const
+            {
+                return nodes.size();
+            }
+
+            //Number of items (boxes given to the last build)
+            std::size_t count() const
+            {
+                return items.size();
+            }
+
+        /* Traversal */
+
+        public:
+
+            /*Call f(item) for every item whose box may overlap the given box (tested against the leaf boxes)
+              If f returns false the traversal stops, the function returns false in that case*/
+            template <class F>
+            bool overlap (const Box &b, F f) const
+            {
+                if (nodes.empty())
+                    return true;
+
+                std::uint32_t stack[64];
+                int top=0;
+                stack[top++]=0;
+                while (top)
+                {
+                    const Node &n=nodes[stack[--top]];
+                    if (!n.box.overlap(b))
+                        continue;
+                    if (n.leaf())
+                    {
+                        for (std::uint32_t i=n.first;i<n.first+n.count;i++)
+                            if (!f(items[i]))
+                                return false;
+                    }
+                    else
+                    {
+                        stack[top++]=n.first+1;
+                        stack[top++]=n.first;
+                    }
+                }
+                return true;
+            }
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_BVH_H_
@@ -0,0 +1,481 @@
+/*
+ * FDX_Cmp.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Cmp
+    Compound shape of parts in local coordinates
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_CMP_H_
+#define _FDX_CMP_H_
+
+
+/* Includes */
+
+//Shapes
+#include "FDX_Geo.hpp"
+
+//Hierarchy of the parts
+#include "FDX_Bvh.hpp"
+
+//Fixed size integers
+#include <cstdint>
+
+//Parts
+#include <vector>
+
+//Min
+#include <algorithm>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    /*Compound shape, made of parts that move together as one unit
+      The parts are kept by value in local coordinates (relative to the origin of the compound), so moving the compound
+      only moves its origin. Queries move the other shape to the local coordinates and visit the parts that may be hit
+      through a small hierarchy of their boxes, which is rebuilt every time the parts change*/
+    class Cmp : public Shp
+    {
+        /* Types */
+
+        public:
+
+            //Part of the compound, type of its shape and index in the parts of that type
+            struct Part
+            {
+                Tag tag;//Type of the shape
+                std::uint32_t i;//Index in the parts of that type
+            };
+
+        /* Attributes */
+
+        /*Position*/
+
+        private:
+
+            Vct r;//Origin of the local coordinates
+
+        /*Parts*/
+
+        private:
+
+            std::vector<Crl> crl;//Circles
+            std::vector<Pnt> pnt;//Points
+            std::vector<Rct> rct;//Rectangles
+            std::vector<Obb> obb;//Oriented rectangles
+            std::vector<Pol> pol;//Convex polygons
+            std::vector<Cap> cap;//Capsules
+
+            std::vector<Part> parts;//Every part, in the order they were added
+
+        /*Bounds*/
+
+        private:
+
+            std::vector<Box> boxes;//Local box of each part
+
+            Bvh bvh;//Hierarchy over the boxes of the parts
+
+            Box bounds;//Local box that contains every part
+
+            Vct::Mod rad;//Radius of the circle around the origin that contains every part
+
+        /* Constructors, copy control */
+
+        /*Constructors*/
+
+        public:
+
+            //Default constructor
+            Cmp()
+            :rad(0)
+            {}
+
+            //Origin constructor
+            explicit Cmp (const Vct &norigin)
+            :r(norigin), rad(0)
+            {}
+
+            //Default copy constructor
+            Cmp (const Cmp&) = default;
+
+        /*Copy control*/
+
+        public:
+
+            //Default copy operator
+            Cmp& operator= (const Cmp &) = default;
+
+            //Destructor
+            virtual ~Cmp() {}
+
+        /* Type */
+
+        public:
+
+            //Get the type of the shape
+            Tag get_tag () const
+            {
+                return Tag::cmp;
+            }
+
+        /* Parts */
+
+        public:
+
+            //Add a circle in local coordinates, returns the index of the part
+            std::size_t add (const Crl &c)
+            {
+                crl.push_back(c);
+                return push(Tag::crl,crl.size()-1);
+            }
+
+            //Add a point in local coordinates, returns the index of the part
+            std::size_t add (const Pnt &p)
+            {
+                pnt.push_back(p);
+                return push(Tag::pnt,pnt.size()-1);
+            }
+
+            //Add a rectangle in local coordinates, returns the index of the part
+            std::size_t add (const Rct &r)
+            {
+                rct.push_back(r);
+                return push(Tag::rct,rct.size()-1);
+            }
+
+            //Add an oriented rectangle in local coordinates, returns the index of the part
+            std::size_t add (const Obb &o)
+            {
+                obb.push_back(o);
+                return push(Tag::obb,obb.size()-1);
+            }
+
+            //Add a convex polygon in local coordinates, returns the index of the part
+            std::size_t add (const Pol &p)
+            {
+                pol.push_back(p);
+                return push(Tag::pol,pol.size()-1);
+            }
+
+            //Add a capsule in local coordinates, returns the index of the part
+            std::size_t add (const Cap &c)
+            {
+                cap.push_back(c);
+                return push(Tag::cap,cap.size()-1);
+            }
+
+            //Number of parts
+            std::size_t get_count () const
+            {
+                return parts.size();
+            }
+
+            //Get a part, in local coordinates
+            const Shp& get_part (std::size_t i) const;
+
+            //Remove every part
+            void clear();
+
+        private:
+
+            //Get a part to change it, in local coordinates
+            Shp& part (std::size_t i);
+
+            //Register the last part of a type, returns its index
+            std::size_t push (Tag tag, std::size_t i);
+
+            //Update the boxes, the bounds and the hierarchy after the parts changed
+            void build();
+
+        /* Position */
+
+        /*Get*/
+
+        public:
+
+            //Get the center of the shape (origin of the local coordinates)
+            Vct get_pos_center () const
+            {
+                return r;
+            }
+
+            //Get the upper left corner of the rectangle that contains the shape completly
+            Vct get_pos_corner () const
+            {
+                return r+bounds.get_min();
+            }
+
+        /*Set*/
+
+        public:
+
+            //Set the center of the shape (origin of the local coordinates)
+            void set_pos_center (const Vct &ncenter)
+            {
+                r=ncenter;
+                touch();
+            }
+
+            //Set the upper left corner of the rectangle that contains the shape completly
+            void set_pos_corner (const Vct &ncorner)
+            {
+                r=ncorner-bounds.get_min();
+                touch();
+            }
+
+        /* Size */
+
+        /*Get*/
+
+        public:
+
+            //Get the size of the circle (around the origin) that contains the shape completly
+            Vct::Mod get_size () const
+            {
+                return rad;
+            }
+
+            //Get the size (diagonal) of the rectangle that contains the shape completly
+            Vct get_diagonal () const
+            {
+                return bounds.get_diagonal();
+            }
+
+        /*Set*/
+
+        public:
+
+            //Set the size of the circle that contains the shape completly (scales the parts around the origin)
+            void set_size (Vct::Mod nsize)
+            {
+                if (rad>0)
+                    scale(nsize/rad);
+            }
+
+            //Set the size (diagonal) of the rectangle that contains the shape completly (scales the parts around the origin to fit in it)
+            void set_diagonal (const Vct &ndiag)
+            {
+                Vct d(get_diagonal());
+                if (d.x>0&&d.y>0)
+                    scale(std::min(ndiag.x/d.x,ndiag.y/d.y));
+            }
+
+        private:
+
+            //Scale the parts around the origin
+            void scale (Vct::Mod k);
+
+        /* Move */
+
+        public:
+
+            //Move the shape by the given vector (moves every part)
+            void mov (const Vct &m)
+            {
+                r+=m;
+                touch();
+            }
+
+        /* Contact */
+
+        public:
+
+            //Contact with a generic shape
+            bool contact (const Shp &s) const;
+
+            //Contact with a circle
+            bool contact (const Crl &c) const;
+
+            //Contact with a point
+            bool contact (const Pnt &p) const;
+
+            //Contact with a rectangle
+            bool contact (const Rct &r) const;
+
+            //Contact with an oriented rectangle
+            bool contact (const Obb &o) const;
+
+            //Contact with a convex polygon
+            bool contact (const Pol &p) const;
+
+            //Contact with a capsule
+            bool contact (const Cap &c) const;
+
+        /* Distance */
+
+        public:
+
+            //Squared distance from a point to the surface of the shape (0 if the point is inside)
+            Vct::Mod sq_dist (const Vct &p) const;
+
+        /* Time to hit */
+
+        public:
+
+            //TTH a generic shape at a given speed
+            Vct::Mod tth (const Shp &s, const Vct &speed) const;
+
+            //TTH a circle at a given speed
+            Vct::Mod tth (const Crl &c, const Vct &speed) const;
+
+            //TTH a point at a given speed
+            Vct::Mod tth (const Pnt &p, const Vct &speed) const;
+
+            //TTH a rectangle at a given speed
+            Vct::Mod tth (const Rct &r, const Vct &speed) const;
+
+            //TTH an oriented rectangle at a given speed
+            Vct::Mod tth (const Obb &o, const Vct &speed) const;
+
+            //TTH a convex polygon at a given speed
+            Vct::Mod tth (const Pol &p, const Vct &speed) const;
+
+            //TTH a capsule at a given speed
+            Vct::Mod tth (const Cap &c, const Vct &speed) const;
+
+        /* Time of impact */
+
+        public:
+
+            //TOI a generic shape at a given speed
+            Toi toi (const Shp &s, const Vct &speed) const;
+
+            //TOI a circle at a given speed
+            Toi toi (const Crl &c, const Vct &speed) const;
+
+            //TOI a point at a given speed
+            Toi toi (const Pnt &p, const Vct &speed) const;
+
+            //TOI a rectangle at a given speed
+            Toi toi (const Rct &r, const Vct &speed) const;
+
+            //TOI an oriented rectangle at a given speed
+            Toi toi (const Obb &o, const Vct &speed) const;
+
+            //TOI a convex polygon at a given speed
+            Toi toi (const Pol &p, const Vct &speed) const;
+
+            //TOI a capsule at a given speed
+            Toi toi (const Cap &c, const Vct &speed) const;
+
+        /* Movement against a shape */
+
+        public:
+
+            //Movement against a generic shape at a given speed
+            Vct mov_against (const Shp &s, const Vct &speed) const;
+
+            //Movement against a circle at a given speed
+            Vct mov_against (const Crl &c, const Vct &speed) const;
+
+            //Movement against a point at a given speed
+            Vct mov_against (const Pnt &p, const Vct &speed) const;
+
+            //Movement against a rectangle at a given speed
+            Vct mov_against (const Rct &r, const Vct &speed) const;
+
+            //Movement against an oriented rectangle at a given speed
+            Vct mov_against (const Obb &o, const Vct &speed) const;
+
+            //Movement against a convex polygon at a given speed
+            Vct mov_against (const Pol &p, const Vct &speed) const;
+
+            //Movement against a capsule at a given speed
+            Vct mov_against (const Cap &c, const Vct &speed) const;
+
+        /* Traversal */
+
+        private:
+
+            /*Call f(i) for every part whose box overlaps the given local box
+              If f returns false the traversal stops, the function returns false in that case*/
+            template <class F>
+            bool overlap (const Box &b, F f) const
+            {
+                return bvh.overlap(b,[this,&b,&f](std::uint32_t i)
+                {
+                    return !boxes[i].overlap(b)||f(i);
+                });
+            }
+
+            /*Part hit first by the compound moving at the given speed against a shape whose local box is given, tth(i) is the TTH of the part i
+              Only the parts whose box may be hit before the best time are tested, the closest first. Returns get_count() if there is no hit*/
+            template <class F>
+            std::size_t first (const Box &b, const Vct &speed, F tth, Vct::Mod &t) const;
+
+            /*Movement limited by the parts: the first part hit that limits it clips it, then the slide is clipped again until
+              no part limits it, even by the parts that clipped it before. If it's still limited after a clip for each part, it stops at the first hit.
+              tth(i,m) and mov(i,m) give the TTH and the movement of the part i at the speed m against the shape whose local box is given*/
+            template <class T, class M>
+            Vct clip (const Box &b, const Vct &speed, T tth, M mov) const;
+
+            //Call f with a copy of the part moved to the global coordinates
+            template <class F>
+            void global_part (std::size_t i, F f) const;
+
+            //TTH of a part, moved to the global coordinates, against a shape
+            Vct::Mod tth_global (std::size_t i, const Shp &s, const Vct &speed) const;
+
+            //Contact with a shape of a concrete type
+            template <class S>
+            bool contact_shp (const S &s) const;
+
+            //TTH a shape of a concrete type
+            template <class S>
+            Vct::Mod tth_shp (const S &s, const Vct &speed) const;
+
+            //TOI a shape of a concrete type
+            template <class S>
+            Toi toi_shp (const S &s, const Vct &speed) const;
+
+            //Movement against a shape of a concrete type
+            template <class S>
+            Vct mov_against_shp (const S &s, const Vct &speed) const;
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_CMP_H_
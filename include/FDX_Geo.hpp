@@ -45,6 +45,15 @@
 //2D vectors
 #include "FDX_Vct.hpp"
 
+//Vertices of polygons
+#include <vector>
+
+//Infinite times
+#include <limits>
+
+//Min, max
+#include <algorithm>
+
 /* Defines */
 
 /*Constants*/
@@ -65,12 +74,27 @@ namespace fdx { namespace arrow
 
     class Rct;//Rectangle shape
 
+    class Obb;//Oriented rectangle shape
+
+    class Pol;//Convex polygon shape
+
+    class Cap;//Capsule shape
+
     class Set;//Set of real values with two limits
 
+    class Box;//Axis aligned box, two sets
+
+    struct Toi;//Time of impact with the contact data
+
+    struct Rgn_hint;//Region of the last hit of a circle or point against a rectangle
+
     /*
         Function prototypes
     */
 
+    //Impact seen from the second shape, moving at the given speed against the first one
+    Toi flip_toi (const Toi &toi, const Vct &speed);
+
     /*
         Data types
      */
@@ -79,9 +103,386 @@ namespace fdx { namespace arrow
 
     /* Classes */
 
+    //Set of real values with two limits
+    class Set
+    {
+        /* Configuration */
+
+        /*Data types*/
+        public:
+
+            //Type of limits
+            typedef double Limit;
+
+            //Type of values
+            typedef double Value;
+
+        /*Constants*/
+        private:
+
+            static constexpr Limit DEF_MIN_LIMIT=0,DEF_MAX_LIMIT=0;//Default set
+            static constexpr Limit DEF_MIN_NULL=0,DEF_MAX_NULL=-1;//Default null set (holds no values)
+
+        /* Attributes */
+
+        /*Limits*/
+        private:
+
+            Limit min_limit, max_limit;
+
+        /* Limit members */
+
+        /*Validity*/
+        public:
+
+            //Check for validity of the set
+            constexpr bool valid() const
+            {
+                return min_limit<=max_limit;
+            }
+
+            //Swap the limit
+            constexpr void swap_limits()
+            {
+                Limit temp=min_limit;
+                min_limit=max_limit;
+                max_limit=temp;
+            }
+
+        /*Set/get*/
+        public:
+
+            //Set limit
+
+            constexpr void set_min(Limit il)
+            {
+                min_limit=il;
+            }
+
+            constexpr void set_max(Limit il)
+            {
+                max_limit=il;
+            }
+
+            //Safe set (swaps limits if necessary)
+
+            constexpr void set_safe_min(Limit il)
+            {
+                set_min(il);
+                if (!valid())
+                    swap_limits();
+            }
+
+            constexpr void set_safe_max(Limit il)
+            {
+                set_max(il);
+                if (!valid())
+                    swap_limits();
+            }
+
+            //Get limits
+
+            constexpr Limit get_min() const
+            {
+                return min_limit;
+            }
+
+            constexpr Limit get_max() const
+            {
+                return max_limit;
+            }
+
+        /*Values*/
+        public:
+
+            //Check if a value is in the set
+            constexpr bool check_value(Value v) const
+            {
+                return(min_limit<=v&&v<=max_limit);
+            }
+
+        /*Size*/
+        public:
+
+            //Get the size
+            constexpr Limit get_size() const
+            {
+                return max_limit-min_limit;
+            }
+
+            //Is elemental
+            constexpr bool elemental() const
+            {
+                return min_limit==max_limit;
+            }
+
+            //Get the center
+            constexpr Limit get_middle() const
+            {
+                return (min_limit+max_limit)/2.0;
+            }
+
+        /* Constructors, copy control */
+
+        /*Constructors*/
+        public:
+
+            //Complete constructor
+            constexpr Set(Limit imin, Limit imax)
+            :min_limit(imin),max_limit(imax)
+            {}
+
+            //Default constructor
+            constexpr Set()
+            :Set(DEF_MIN_LIMIT,DEF_MAX_LIMIT)
+            {}
+
+            //Copy constructor
+            constexpr Set(const Set& s)
+            :Set(s.min_limit,s.max_limit)
+            {}
+
+        /*Operators*/
+        public:
+
+            //Assignment operator
+            constexpr Set& operator= (const Set& s)
+            {
+                min_limit=s.min_limit;
+                max_limit=s.max_limit;
+                return *this;
+            }
+
+            //Mulitply and assign operator
+            constexpr void operator*= (Limit m)
+            {
+                min_limit*=m;
+                max_limit*=m;
+                if (m<0)
+                    swap_limits();
+            }
+
+        /* Set methods */
+
+        /*Intersect*/
+        public:
+
+            //Return the intersection of two sets
+            static constexpr Set min_intersect(const Set& s1, const Set& s2)
+            {
+                return Set(std::max(s1.get_min(),s2.get_min()),std::min(s1.get_max(),s2.get_max()));
+            }
+
+            //Returns the big union of two sets (no gaps)
+            static constexpr Set max_union(const Set &s1, const Set& s2)
+            {
+                return Set(std::min(s1.get_min(),s2.get_min()),std::max(s1.get_max(),s2.get_max()));
+            }
+
+        /*TTH*/
+        public:
+
+            //TTH a point
+            constexpr Set tth(Value v, Value speed) const
+            {
+                //Check for static or dynamic tth
+                if (speed)//Dynamic tth
+                {
+                    Set rv(v-get_max(),v-get_min());//Distance
+                    rv*=(1.0/speed);//Get the distance to time dividing it by the speed
+                    return rv;
+                }
+                else//Static tth
+                {
+                    //Check if the value is inside the set
+                    if (check_value(v))
+                        return Set(DEF_MIN_LIMIT,DEF_MAX_LIMIT);//Default values hold the appropiate time value for infinite
+                    else
+                        return Set(DEF_MIN_NULL,DEF_MAX_NULL);//Null value indicates that there's no time value that puts the set in contact with it
+                }
+            }
+
+            /*TTH a set
+              The static union is written out, GCC 12 crashes (internal error) vectorizing loops of the generic union*/
+            constexpr Set tth(const Set& s, Value speed) const
+            {
+                if (!speed)//Static tth, any limit inside the set
+                {
+                    if (check_value(s.get_min())||check_value(s.get_max()))
+                        return Set(DEF_MIN_LIMIT,DEF_MAX_LIMIT);
+                    else
+                        return Set(DEF_MIN_NULL,DEF_MAX_NULL);
+                }
+                return max_union(tth(s.get_min(),speed),tth(s.get_max(),speed));
+            }
+    };
+
+    //Axis aligned box, made of the sets of its X and Y coordinates
+    class Box
+    {
+        /* Attributes */
+
+        /*Sets*/
+        public:
+
+            Set x, y;//Coordinates covered by the box
+
+        /* Constructors, copy control */
+
+        /*Constructors*/
+        public:
+
+            //Default constructor
+            constexpr Box() = default;
+
+            //Complete constructor
+            constexpr Box(const Set &nx, const Set &ny)
+            :x(nx), y(ny)
+            {}
+
+            //Corner and diagonal constructor
+            constexpr Box(const Vct &corner, const Vct &diagonal)
+            :x(corner.x,corner.x+diagonal.x), y(corner.y,corner.y+diagonal.y)
+            {}
+
+            //Box that contains a shape completly
+            explicit constexpr Box(const Shp &s);
+
+        /* Position and size */
+        public:
+
+            //Get the upper left corner
+            constexpr Vct get_min() const
+            {
+                return Vct(x.get_min(),y.get_min());
+            }
+
+            //Get the lower right corner
+            constexpr Vct get_max() const
+            {
+                return Vct(x.get_max(),y.get_max());
+            }
+
+            //Get the center
+            constexpr Vct get_center() const
+            {
+                return Vct(x.get_middle(),y.get_middle());
+            }
+
+            //Get the diagonal
+            constexpr Vct get_diagonal() const
+            {
+                return Vct(x.get_size(),y.get_size());
+            }
+
+        /* Box methods */
+        public:
+
+            //Check if two boxes overlap (borders included)
+            constexpr bool overlap(const Box &b) const
+            {
+                return  x.get_min()<=b.x.get_max()&&b.x.get_min()<=x.get_max()
+                        &&
+                        y.get_min()<=b.y.get_max()&&b.y.get_min()<=y.get_max();
+            }
+
+            //Check if a point is inside the box
+            constexpr bool check_value(const Vct &v) const
+            {
+                return x.check_value(v.x)&&y.check_value(v.y);
+            }
+
+            //Get the point of the box closest to the given point
+            constexpr Vct closest(const Vct &v) const
+            {
+                return Vct(std::min(std::max(v.x,x.get_min()),x.get_max()),std::min(std::max(v.y,y.get_min()),y.get_max()));
+            }
+
+            //Squared distance from a point to the box (0 if the point is inside)
+            constexpr Vct::Mod sq_dist(const Vct &v) const
+            {
+                return (closest(v)-v).sq_mod();
+            }
+
+            //Returns the smallest box that contains both boxes
+            static constexpr Box max_union(const Box &b1, const Box &b2)
+            {
+                return Box(Set::max_union(b1.x,b2.x),Set::max_union(b1.y,b2.y));
+            }
+
+            //Returns the box covered by this box when it moves at the given speed for a tick
+            constexpr Box swept(const Vct &speed) const
+            {
+                Box m(*this);
+                m.x.set_min(x.get_min()+std::min(speed.x,0.0));
+                m.x.set_max(x.get_max()+std::max(speed.x,0.0));
+                m.y.set_min(y.get_min()+std::min(speed.y,0.0));
+                m.y.set_max(y.get_max()+std::max(speed.y,0.0));
+                return m;
+            }
+
+        /*TTH*/
+        public:
+
+            //Times in which this box, moving at the given speed, overlaps another box (not valid if never)
+            constexpr Set tth(const Box &b, const Vct &speed) const;
+    };
+
+    //Time of impact of a shape moving against another, with the data of the contact
+    struct Toi
+    {
+        //Feature of the contact
+        enum class Feature : unsigned char
+        {
+            none,//No contact
+            round,//Between circles or points
+            side,//Against the side of a rectangle
+            corner,//Against the corner of a rectangle
+            center//Center of a shape inside a rectangle
+        };
+
+        Vct::Mod t;//Time to hit, negative if there is no hit
+        Vct normal;//Unitary normal of the contact, from the second shape to the first
+        Vct point;//Point of contact (the second shape doesn't move)
+        Feature feature;//Feature of the contact
+    };
+
+    /*Region of the last hit of a circle or point against a rectangle, kept by the caller for each pair
+      A TTH with a hint checks first the side or corner of the region, only walking through the regions if it's not the first hit*/
+    struct Rgn_hint
+    {
+        int px=0, py=0;//Region of the circle at the hit (-1,0,1 as the walk), 0,0 if there's no hint
+    };
+
     //Generic shape
     class Shp
     {
+        /* Types */
+
+        public:
+
+            //Type of the shape
+            enum class Tag : unsigned char
+            {
+                crl,//Circle
+                pnt,//Point
+                rct,//Rectangle
+                obb,//Oriented rectangle
+                pol,//Convex polygon
+                cap,//Capsule
+                cmp//Compound
+            };
+
+        /* Attributes */
+
+        /*Bounds*/
+
+        private:
+
+            mutable Box bound_box;//Box that contains the shape, computed on demand
+
+            mutable bool bound_dirty=true;//The box must be computed again
+
         /* Constructors, copy control */
 
         /*Constructors*/
@@ -89,22 +490,758 @@ namespace fdx { namespace arrow
         protected:
 
             //Default constructor
-            Shp() = default;
+            Shp() = default;
+
+            //Default copy constructor
+            Shp (const Shp&) = default;
+
+        /*Copy control*/
+
+        protected:
+
+            //Default copy constructor
+            Shp& operator= (const Shp &) = default;
+
+        public:
+
+            //Virtual destructor (allows the class to be extended)
+            constexpr virtual ~Shp() {}
+
+        /* Type */
+
+        public:
+
+            //Get the type of the shape
+            virtual Tag get_tag () const = 0;
+
+        /* Position */
+
+        /*Get*/
+
+        public:
+
+            //Get the center of the shape
+            virtual Vct get_pos_center () const = 0;
+
+            //Get the upper left corner of the rectangle that contains the shape completly
+            virtual Vct get_pos_corner () const = 0;
+
+        /*Set*/
+
+        public:
+
+            //Set the center of the shape
+            virtual void set_pos_center (const Vct &ncenter) = 0;
+
+            //Set the upper left corner of the rectangle that contains the shape completly
+            virtual void set_pos_corner (const Vct &ncorner) = 0;
+
+        /* Size */
+
+        /*Get*/
+
+        public:
+
+            //Get the size of the circle that contains the shape completly
+            virtual Vct::Mod get_size () const = 0;
+
+            //Get the size (diagonal) of the rectangle that contains the shape completly
+            virtual Vct get_diagonal () const = 0;
+
+        /*Set*/
+
+        public:
+
+            //Set the size of the circle that contains the shape completly
+            virtual void set_size (Vct::Mod nsize) = 0;
+
+            //Set the size (diagonal) of the rectangle that contains the shape completly
+            virtual void set_diagonal (const Vct &ndiag) = 0;
+
+        /* Bounds */
+
+        public:
+
+            /*Get the box that contains the shape completly, it's only computed again after the shape changes
+              The first call after a change writes the box, so it must not be done by several threads at once*/
+            const Box& get_bounds () const
+            {
+                if (bound_dirty)
+                {
+                    bound_box=Box(get_pos_corner(),get_diagonal());
+                    bound_dirty=false;
+                }
+                return bound_box;
+            }
+
+        protected:
+
+            //Mark the box as outdated, every change of the position, size or form of the shape must call it
+            void touch ()
+            {
+                bound_dirty=true;
+            }
+
+        /* Move */
+
+        public:
+
+            //Move the shape by the given vector
+            virtual void mov (const Vct &m) = 0;
+
+        /* Contact */
+
+        public:
+
+            //Contact with a generic shape
+            virtual bool contact (const Shp &s) const = 0;
+
+            //Contact with a circle
+            virtual bool contact (const Crl &c) const = 0;
+
+            //Contact with a point
+            virtual bool contact (const Pnt &p) const = 0;
+
+            //Contact with a rectangle
+            virtual bool contact (const Rct &r) const = 0;
+
+            //Contact with an oriented rectangle
+            virtual bool contact (const Obb &o) const = 0;
+
+            //Contact with a convex polygon
+            virtual bool contact (const Pol &p) const = 0;
+
+            //Contact with a capsule
+            virtual bool contact (const Cap &c) const = 0;
+
+        /* Distance */
+
+        public:
+
+            //Squared distance from a point to the surface of the shape (0 if the point is inside)
+            virtual Vct::Mod sq_dist (const Vct &p) const = 0;
+
+        /* Time to hit */
+
+        public:
+
+            /*Times are in ticks of the given speed, 0 if the shapes are already in contact and negative if they never hit
+              They are not limited to the tick, a time above 1 is a hit after it*/
+
+            //TTH a generic shape at a given speed
+            virtual Vct::Mod tth (const Shp &s, const Vct &speed) const = 0;
+
+            //TTH a circle at a given speed
+            virtual Vct::Mod tth (const Crl &c, const Vct &speed) const = 0;
+
+            //TTH a point at a given speed
+            virtual Vct::Mod tth (const Pnt &p, const Vct &speed) const = 0;
+
+            //TTH a rectangle at a given speed
+            virtual Vct::Mod tth (const Rct &r, const Vct &speed) const = 0;
+
+            //TTH an oriented rectangle at a given speed
+            virtual Vct::Mod tth (const Obb &o, const Vct &speed) const = 0;
+
+            //TTH a convex polygon at a given speed
+            virtual Vct::Mod tth (const Pol &p, const Vct &speed) const = 0;
+
+            //TTH a capsule at a given speed
+            virtual Vct::Mod tth (const Cap &c, const Vct &speed) const = 0;
+
+        /* Time of impact */
+
+        public:
+
+            //TOI a generic shape at a given speed
+            virtual Toi toi (const Shp &s, const Vct &speed) const = 0;
+
+            //TOI a circle at a given speed
+            virtual Toi toi (const Crl &c, const Vct &speed) const = 0;
+
+            //TOI a point at a given speed
+            virtual Toi toi (const Pnt &p, const Vct &speed) const = 0;
+
+            //TOI a rectangle at a given speed
+            virtual Toi toi (const Rct &r, const Vct &speed) const = 0;
+
+            //TOI an oriented rectangle at a given speed
+            virtual Toi toi (const Obb &o, const Vct &speed) const = 0;
+
+            //TOI a convex polygon at a given speed
+            virtual Toi toi (const Pol &p, const Vct &speed) const = 0;
+
+            //TOI a capsule at a given speed
+            virtual Toi toi (const Cap &c, const Vct &speed) const = 0;
+
+        /* Movement against a shape */
+
+        public:
+
+            //Movement against a generic shape at a given speed
+            virtual Vct mov_against (const Shp &s, const Vct &speed) const = 0;
+
+            //Movement against a circle at a given speed
+            virtual Vct mov_against (const Crl &c, const Vct &speed) const = 0;
+
+            //Movement against a point at a given speed
+            virtual Vct mov_against (const Pnt &p, const Vct &speed) const = 0;
+
+            //Movement against a rectangle at a given speed
+            virtual Vct mov_against (const Rct &r, const Vct &speed) const = 0;
+
+            //Movement against an oriented rectangle at a given speed
+            virtual Vct mov_against (const Obb &o, const Vct &speed) const = 0;
+
+            //Movement against a convex polygon at a given speed
+            virtual Vct mov_against (const Pol &p, const Vct &speed) const = 0;
+
+            //Movement against a capsule at a given speed
+            virtual Vct mov_against (const Cap &c, const Vct &speed) const = 0;
+    };
+
+    //Box that contains a shape completly
+    constexpr Box::Box(const Shp &s)
+    :Box(s.get_pos_corner(),s.get_diagonal())
+    {}
+
+    //Circle
+    class Crl : public Shp
+    {
+        /* Attributes */
+
+        /*Position*/
+
+        private:
+
+            Vct r;//Center of the circle
+
+        /*Size*/
+
+        private:
+
+            Vct::Mod s;//Radius of the circle
+
+        /* Constructors, copy control */
+
+        /*Constructors*/
+
+        public:
+
+            //Default constructor
+            Crl() = default;
+
+            //Complete constructor
+            constexpr Crl (const Vct &nr, Vct::Mod ns)
+            :r(nr), s(ns)
+            {}
+
+            //Default copy constructor
+            Crl (const Crl &) = default;
+
+        /*Copy control*/
+
+        public:
+
+            //Default copy operator
+            Crl& operator= (const Crl &) = default;
+
+            //Destructor
+            constexpr virtual ~Crl() {}
+
+        /* Type */
+
+        public:
+
+            //Get the type of the shape
+            constexpr Tag get_tag () const
+            {
+                return Tag::crl;
+            }
+
+        /* Position */
+
+        /*Get*/
+
+        public:
+
+            //Get the center of the shape
+            constexpr Vct get_pos_center () const
+            {
+                return r;
+            }
+
+            //Get the upper left corner of the rectangle that contains the shape completly
+            constexpr Vct get_pos_corner () const
+            {
+                return r+Vct(-s,-s);
+            }
+
+        /*Set*/
+
+        public:
+
+            //Set the center of the shape
+            void set_pos_center (const Vct &ncenter)
+            {
+                r=ncenter;
+                touch();
+            }
+
+            //Set the upper left corner of the rectangle that contains the shape completly
+            void set_pos_corner (const Vct &ncorner)
+            {
+                r=ncorner+Vct(s,s);
+                touch();
+            }
+
+        /* Size */
+
+        /*Get*/
+
+        public:
+
+            //Get the size of the circle that contains the shape completly
+            constexpr Vct::Mod get_size () const
+            {
+                return s;
+            }
+
+            //Get the size (diagonal) of the rectangle that contains the shape completly
+            constexpr Vct get_diagonal () const
+            {
+                return Vct(2*s,2*s);
+            }
+
+        /*Set*/
+
+        public:
+
+            //Set the size of the circle that contains the shape completly
+            void set_size (Vct::Mod nsize)
+            {
+                s=nsize;
+                touch();
+            }
+
+            //Set the size (diagonal) of the rectangle that contains the shape completly
+            void set_diagonal (const Vct &ndiag)
+            {
+                s=std::min(ndiag.x,ndiag.y);
+                touch();
+            }
+
+        /* Move */
+
+        public:
+
+            //Move the shape by the given vector
+            void mov (const Vct &m)
+            {
+                r+=m;
+                touch();
+            }
+
+        /* Contact */
+
+        public:
+
+            //Contact with a generic shape
+            bool contact (const Shp &s) const;
+
+            //Contact with a circle
+            bool contact (const Crl &c) const;
+
+            //Contact with a point
+            bool contact (const Pnt &p) const;
+
+            //Contact with a rectangle
+            bool contact (const Rct &r) const;
+
+            //Contact with an oriented rectangle
+            bool contact (const Obb &o) const;
+
+            //Contact with a convex polygon
+            bool contact (const Pol &p) const;
+
+            //Contact with a capsule
+            bool contact (const Cap &c) const;
+
+        /* Distance */
+
+        public:
+
+            //Squared distance from a point to the surface of the shape (0 if the point is inside)
+            Vct::Mod sq_dist (const Vct &p) const;
+
+        /* Time to hit */
+
+        public:
+
+            //TTH a generic shape at a given speed
+            Vct::Mod tth (const Shp &s, const Vct &speed) const;
+
+            //TTH a circle at a given speed
+            Vct::Mod tth (const Crl &c, const Vct &speed) const;
+
+            //TTH a point at a given speed
+            Vct::Mod tth (const Pnt &p, const Vct &speed) const;
+
+            //TTH a rectangle at a given speed (negative if they never hit and not limited to the tick, it used to return 1 for both)
+            Vct::Mod tth (const Rct &r, const Vct &speed) const;
+
+            //TTH a rectangle at a given speed, starting by the region of the hint (updated with the result)
+            Vct::Mod tth (const Rct &r, const Vct &speed, Rgn_hint &hint) const;
+
+            //TTH an oriented rectangle at a given speed
+            Vct::Mod tth (const Obb &o, const Vct &speed) const;
+
+            //TTH a convex polygon at a given speed
+            Vct::Mod tth (const Pol &p, const Vct &speed) const;
+
+            //TTH a capsule at a given speed
+            Vct::Mod tth (const Cap &c, const Vct &speed) const;
+
+        /* Time of impact */
+
+        public:
+
+            //TOI a generic shape at a given speed
+            Toi toi (const Shp &s, const Vct &speed) const;
+
+            //TOI a circle at a given speed
+            Toi toi (const Crl &c, const Vct &speed) const;
+
+            //TOI a point at a given speed
+            Toi toi (const Pnt &p, const Vct &speed) const;
+
+            //TOI a rectangle at a given speed
+            Toi toi (const Rct &r, const Vct &speed) const;
+
+            //TOI an oriented rectangle at a given speed
+            Toi toi (const Obb &o, const Vct &speed) const;
+
+            //TOI a convex polygon at a given speed
+            Toi toi (const Pol &p, const Vct &speed) const;
+
+            //TOI a capsule at a given speed
+            Toi toi (const Cap &c, const Vct &speed) const;
+
+        /* Movement against a shape */
+
+        public:
+
+            //Movement against a generic shape at a given speed
+            Vct mov_against (const Shp &s, const Vct &speed) const;
+
+            //Movement against a circle at a given speed
+            Vct mov_against (const Crl &c, const Vct &speed) const;
+
+            //Movement against a point at a given speed
+            Vct mov_against (const Pnt &p, const Vct &speed) const;
+
+            //Movement against a rectangle at a given speed
+            Vct mov_against (const Rct &r, const Vct &speed) const;
+
+            //Movement against an oriented rectangle at a given speed
+            Vct mov_against (const Obb &o, const Vct &speed) const;
+
+            //Movement against a convex polygon at a given speed
+            Vct mov_against (const Pol &p, const Vct &speed) const;
+
+            //Movement against a capsule at a given speed
+            Vct mov_against (const Cap &c, const Vct &speed) const;
+    };
+
+    //Point
+    class Pnt : public Shp
+    {
+        /* Attributes */
+
+        /*Position*/
+
+        private:
+
+            Vct r;//Point position
+
+        /* Constructors, copy control */
+
+        /*Constructors*/
+
+        public:
+
+            //Default constructor
+            Pnt() = default;
+
+            //Complete constructor
+            constexpr Pnt (const Vct &nr)
+            :r(nr)
+            {}
+
+            //Default copy constructor
+            Pnt (const Pnt &) = default;
+
+        /*Copy control*/
+
+        public:
+
+            //Default copy operator
+            Pnt& operator= (const Pnt &) = default;
+
+            //Destructor
+            constexpr virtual ~Pnt() {}
+
+        /* Type */
+
+        public:
+
+            //Get the type of the shape
+            constexpr Tag get_tag () const
+            {
+                return Tag::pnt;
+            }
+
+        /* Position */
+
+        /*Get*/
+
+        public:
+
+            //Get the center of the shape
+            constexpr Vct get_pos_center () const
+            {
+                return r;
+            }
+
+            //Get the upper left corner of the rectangle that contains the shape completly
+            constexpr Vct get_pos_corner () const
+            {
+                return r;
+            }
+
+        /*Set*/
+
+        public:
+
+            //Set the center of the shape
+            void set_pos_center (const Vct &ncenter)
+            {
+                r=ncenter;
+                touch();
+            }
+
+            //Set the upper left corner of the rectangle that contains the shape completly
+            void set_pos_corner (const Vct &ncorner)
+            {
+                r=ncorner;
+                touch();
+            }
+
+        /* Size */
+
+        /*Get*/
+
+        public:
+
+            //Get the size of the circle that contains the shape completly
+            constexpr Vct::Mod get_size () const
+            {
+                return 0;
+            }
+
+            //Get the size (diagonal) of the rectangle that contains the shape completly
+            constexpr Vct get_diagonal () const
+            {
+                return Vct(0,0);
+            }
+
+        /*Set*/
+
+        public:
+
+            //Set the size of the circle that contains the shape completly
+            void set_size (Vct::Mod)
+            {
+                return;//This function does nothing on a point
+            }
+
+            //Set the size (diagonal) of the rectangle that contains the shape completly
+            void set_diagonal (const Vct &)
+            {
+                return;//This function does nothing on a point
+            }
+
+        /* Move */
+
+        public:
+
+            //Move the shape by the given vector
+            void mov (const Vct &m)
+            {
+                r+=m;
+                touch();
+            }
+
+        /* Contact */
+
+        public:
+
+            //Contact with a generic shape
+            bool contact (const Shp &s) const;
+
+            //Contact with a circle
+            bool contact (const Crl &c) const;
+
+            //Contact with a point
+            bool contact (const Pnt &p) const;
+
+            //Contact with a rectangle
+            bool contact (const Rct &r) const;
+
+            //Contact with an oriented rectangle
+            bool contact (const Obb &o) const;
+
+            //Contact with a convex polygon
+            bool contact (const Pol &p) const;
+
+            //Contact with a capsule
+            bool contact (const Cap &c) const;
+
+        /* Distance */
+
+        public:
+
+            //Squared distance from a point to the surface of the shape (0 if the point is inside)
+            Vct::Mod sq_dist (const Vct &p) const;
+
+        /* Time to hit */
+
+        public:
+
+            //TTH a generic shape at a given speed
+            Vct::Mod tth (const Shp &s, const Vct &speed) const;
+
+            //TTH a circle at a given speed
+            Vct::Mod tth (const Crl &c, const Vct &speed) const;
+
+            //TTH a point at a given speed
+            Vct::Mod tth (const Pnt &p, const Vct &speed) const;
+
+            //TTH a rectangle at a given speed
+            Vct::Mod tth (const Rct &r, const Vct &speed) const;
+
+            //TTH a rectangle at a given speed, starting by the region of the hint (updated with the result)
+            Vct::Mod tth (const Rct &r, const Vct &speed, Rgn_hint &hint) const;
+
+            //TTH an oriented rectangle at a given speed
+            Vct::Mod tth (const Obb &o, const Vct &speed) const;
+
+            //TTH a convex polygon at a given speed
+            Vct::Mod tth (const Pol &p, const Vct &speed) const;
+
+            //TTH a capsule at a given speed
+            Vct::Mod tth (const Cap &c, const Vct &speed) const;
+
+        /* Time of impact */
+
+        public:
+
+            //TOI a generic shape at a given speed
+            Toi toi (const Shp &s, const Vct &speed) const;
+
+            //TOI a circle at a given speed
+            Toi toi (const Crl &c, const Vct &speed) const;
+
+            //TOI a point at a given speed
+            Toi toi (const Pnt &p, const Vct &speed) const;
+
+            //TOI a rectangle at a given speed
+            Toi toi (const Rct &r, const Vct &speed) const;
+
+            //TOI an oriented rectangle at a given speed
+            Toi toi (const Obb &o, const Vct &speed) const;
+
+            //TOI a convex polygon at a given speed
+            Toi toi (const Pol &p, const Vct &speed) const;
+
+            //TOI a capsule at a given speed
+            Toi toi (const Cap &c, const Vct &speed) const;
+
+        /* Movement against a shape */
+
+        public:
+
+            //Movement against a generic shape at a given speed
+            Vct mov_against (const Shp &s, const Vct &speed) const;
+
+            //Movement against a circle at a given speed
+            Vct mov_against (const Crl &c, const Vct &speed) const;
+
+            //Movement against a point at a given speed
+            Vct mov_against (const Pnt &p, const Vct &speed) const;
+
+            //Movement against a rectangle at a given speed
+            Vct mov_against (const Rct &r, const Vct &speed) const;
+
+            //Movement against an oriented rectangle at a given speed
+            Vct mov_against (const Obb &o, const Vct &speed) const;
+
+            //Movement against a convex polygon at a given speed
+            Vct mov_against (const Pol &p, const Vct &speed) const;
+
+            //Movement against a capsule at a given speed
+            Vct mov_against (const Cap &c, const Vct &speed) const;
+    };
+
+    //Rectangle
+    class Rct : public Shp
+    {
+        /* Attributes */
+
+        /*Position*/
+
+        private:
+
+            Vct r;//Upper left corner position
+
+            Vct s;//Size, from the upper left corner to the opposite corner
+
+        /* Constructors, copy control */
+
+        /*Constructors*/
+
+        public:
+
+            //Default constructor
+            Rct() = default;
+
+            //Complete constructor
+            constexpr Rct (const Vct &nr, const Vct &ns)
+            :r(nr), s(ns)
+            {}
 
             //Default copy constructor
-            Shp (const Shp&) = default;
+            Rct (const Rct&) = default;
 
         /*Copy control*/
 
-        protected:
+        public:
 
             //Default copy constructor
-            Shp& operator= (const Shp &) = default;
+            Rct& operator= (const Rct &) = default;
+
+            //Destructor
+            constexpr virtual ~Rct() {}
+
+        /* Type */
 
         public:
 
-            //Virtual destructor (allows the class to be extended)
-            virtual ~Shp() {}
+            //Get the type of the shape
+            constexpr Tag get_tag () const
+            {
+                return Tag::rct;
+            }
 
         /* Position */
 
@@ -113,20 +1250,34 @@ namespace fdx { namespace arrow
         public:
 
             //Get the center of the shape
-            virtual Vct get_pos_center () const = 0;
+            constexpr Vct get_pos_center () const
+            {
+                return r+0.5*s;
+            }
 
             //Get the upper left corner of the rectangle that contains the shape completly
-            virtual Vct get_pos_corner () const = 0;
+            constexpr Vct get_pos_corner () const
+            {
+                return r;
+            }
 
         /*Set*/
 
         public:
 
             //Set the center of the shape
-            virtual void set_pos_center (const Vct &ncenter) = 0;
+            void set_pos_center (const Vct &ncenter)
+            {
+                r=ncenter-0.5*s;
+                touch();
+            }
 
             //Set the upper left corner of the rectangle that contains the shape completly
-            virtual void set_pos_corner (const Vct &ncorner) = 0;
+            void set_pos_corner (const Vct &ncorner)
+            {
+                r=ncorner;
+                touch();
+            }
 
         /* Size */
 
@@ -135,79 +1286,158 @@ namespace fdx { namespace arrow
         public:
 
             //Get the size of the circle that contains the shape completly
-            virtual Vct::Mod get_size () const = 0;
+            Vct::Mod get_size () const
+            {
+                return 0.5*s.mod();
+            }
 
             //Get the size (diagonal) of the rectangle that contains the shape completly
-            virtual Vct get_diagonal () const = 0;
+            constexpr Vct get_diagonal () const
+            {
+                return s;
+            }
 
         /*Set*/
 
         public:
 
             //Set the size of the circle that contains the shape completly
-            virtual void set_size (Vct::Mod nsize) = 0;
+            void set_size (Vct::Mod nsize)
+            {
+                s=Vct(2*nsize,2*nsize);
+                touch();
+            }
 
             //Set the size (diagonal) of the rectangle that contains the shape completly
-            virtual void set_diagonal (const Vct &ndiag) = 0;
+            void set_diagonal (const Vct &ndiag)
+            {
+                s=ndiag;
+                touch();
+            }
 
         /* Move */
 
         public:
 
             //Move the shape by the given vector
-            virtual void mov (const Vct &m) = 0;
+            void mov (const Vct &m)
+            {
+                r+=m;
+                touch();
+            }
 
         /* Contact */
 
         public:
 
             //Contact with a generic shape
-            virtual bool contact (const Shp &s) const = 0;
+            bool contact (const Shp &s) const;
 
             //Contact with a circle
-            virtual bool contact (const Crl &c) const = 0;
+            bool contact (const Crl &c) const;
 
             //Contact with a point
-            virtual bool contact (const Pnt &p) const = 0;
+            bool contact (const Pnt &p) const;
 
             //Contact with a rectangle
-            virtual bool contact (const Rct &r) const = 0;
+            bool contact (const Rct &r) const;
+
+            //Contact with an oriented rectangle
+            bool contact (const Obb &o) const;
+
+            //Contact with a convex polygon
+            bool contact (const Pol &p) const;
+
+            //Contact with a capsule
+            bool contact (const Cap &c) const;
+
+        /* Distance */
+
+        public:
+
+            //Squared distance from a point to the surface of the shape (0 if the point is inside)
+            Vct::Mod sq_dist (const Vct &p) const;
+
 
         /* Time to hit */
 
         public:
 
             //TTH a generic shape at a given speed
-            virtual Vct::Mod tth (const Shp &s, const Vct &speed) const = 0;
+            Vct::Mod tth (const Shp &s, const Vct &speed) const;
 
             //TTH a circle at a given speed
-            virtual Vct::Mod tth (const Crl &c, const Vct &speed) const = 0;
+            Vct::Mod tth (const Crl &c, const Vct &speed) const;
 
             //TTH a point at a given speed
-            virtual Vct::Mod tth (const Pnt &p, const Vct &speed) const = 0;
+            Vct::Mod tth (const Pnt &p, const Vct &speed) const;
 
-            //TTH a rectangle at a given speed
-            virtual Vct::Mod tth (const Rct &r, const Vct &speed) const = 0;
+            //TTH a point at a given speed
+            Vct::Mod tth (const Rct &r, const Vct &speed) const;
+
+            //TTH an oriented rectangle at a given speed
+            Vct::Mod tth (const Obb &o, const Vct &speed) const;
+
+            //TTH a convex polygon at a given speed
+            Vct::Mod tth (const Pol &p, const Vct &speed) const;
+
+            //TTH a capsule at a given speed
+            Vct::Mod tth (const Cap &c, const Vct &speed) const;
+
+        /* Time of impact */
+
+        public:
+
+            //TOI a generic shape at a given speed
+            Toi toi (const Shp &s, const Vct &speed) const;
+
+            //TOI a circle at a given speed
+            Toi toi (const Crl &c, const Vct &speed) const;
+
+            //TOI a point at a given speed
+            Toi toi (const Pnt &p, const Vct &speed) const;
+
+            //TOI a rectangle at a given speed
+            Toi toi (const Rct &r, const Vct &speed) const;
+
+            //TOI an oriented rectangle at a given speed
+            Toi toi (const Obb &o, const Vct &speed) const;
+
+            //TOI a convex polygon at a given speed
+            Toi toi (const Pol &p, const Vct &speed) const;
+
+            //TOI a capsule at a given speed
+            Toi toi (const Cap &c, const Vct &speed) const;
 
         /* Movement against a shape */
 
         public:
 
             //Movement against a generic shape at a given speed
-            virtual Vct mov_against (const Shp &s, const Vct &speed) const = 0;
+            Vct mov_against (const Shp &s, const Vct &speed) const;
 
             //Movement against a circle at a given speed
-            virtual Vct mov_against (const Crl &c, const Vct &speed) const = 0;
+            Vct mov_against (const Crl &c, const Vct &speed) const;
 
             //Movement against a point at a given speed
-            virtual Vct mov_against (const Pnt &p, const Vct &speed) const = 0;
+            Vct mov_against (const Pnt &p, const Vct &speed) const;
+
+            //Movement against a point at a given speed
+            Vct mov_against (const Rct &r, const Vct &speed) const;
+
+            //Movement against an oriented rectangle at a given speed
+            Vct mov_against (const Obb &o, const Vct &speed) const;
+
+            //Movement against a convex polygon at a given speed
+            Vct mov_against (const Pol &p, const Vct &speed) const;
+
+            //Movement against a capsule at a given speed
+            Vct mov_against (const Cap &c, const Vct &speed) const;
 
-            //Movement against a rectangle at a given speed
-            virtual Vct mov_against (const Rct &r, const Vct &speed) const = 0;
     };
 
-    //Circle
-    class Crl : public Shp
+    //Oriented rectangle
+    class Obb : public Shp
     {
         /* Attributes */
 
@@ -215,13 +1445,11 @@ namespace fdx { namespace arrow
 
         private:
 
-            Vct r;//Center of the circle
-
-        /*Size*/
+            Vct r;//Center of the rectangle
 
-        private:
+            Vct s;//Size, along the axes of the rectangle
 
-            Vct::Mod s;//Radius of the circle
+            Vct u;//Unitary X axis of the rectangle (the Y axis is perpendicular to it)
 
         /* Constructors, copy control */
 
@@ -230,25 +1458,42 @@ namespace fdx { namespace arrow
         public:
 
             //Default constructor
-            Crl() = default;
+            Obb()
+            :u(1,0)
+            {}
 
-            //Complete constructor
-            Crl (const Vct &nr, Vct::Mod ns)
-            :r(nr), s(ns)
+            //Complete constructor (the angle is the one of the X axis of the rectangle)
+            Obb (const Vct &nr, const Vct &ns, Vct::Mod nangle)
+            :r(nr), s(ns), u(Vct::mk_ang_mod(nangle,1))
+            {}
+
+            //Constructor from a rectangle, not rotated
+            explicit Obb (const Rct &nrct)
+            :r(nrct.get_pos_center()), s(nrct.get_diagonal()), u(1,0)
             {}
 
             //Default copy constructor
-            Crl (const Crl &) = default;
+            Obb (const Obb&) = default;
 
         /*Copy control*/
 
         public:
 
             //Default copy operator
-            Crl& operator= (const Crl &) = default;
+            Obb& operator= (const Obb &) = default;
 
             //Destructor
-            virtual ~Crl() {}
+            virtual ~Obb() {}
+
+        /* Type */
+
+        public:
+
+            //Get the type of the shape
+            Tag get_tag () const
+            {
+                return Tag::obb;
+            }
 
         /* Position */
 
@@ -265,7 +1510,7 @@ namespace fdx { namespace arrow
             //Get the upper left corner of the rectangle that contains the shape completly
             Vct get_pos_corner () const
             {
-                return r+Vct(-s,-s);
+                return r-0.5*get_diagonal();
             }
 
         /*Set*/
@@ -276,12 +1521,14 @@ namespace fdx { namespace arrow
             void set_pos_center (const Vct &ncenter)
             {
                 r=ncenter;
+                touch();
             }
 
             //Set the upper left corner of the rectangle that contains the shape completly
             void set_pos_corner (const Vct &ncorner)
             {
-                r=ncorner+Vct(s,s);
+                r=ncorner+0.5*get_diagonal();
+                touch();
             }
 
         /* Size */
@@ -293,13 +1540,19 @@ namespace fdx { namespace arrow
             //Get the size of the circle that contains the shape completly
             Vct::Mod get_size () const
             {
-                return s;
+                return 0.5*s.mod();
             }
 
             //Get the size (diagonal) of the rectangle that contains the shape completly
             Vct get_diagonal () const
             {
-                return Vct(2*s,2*s);
+                return Vct(std::abs(u.x)*s.x+std::abs(u.y)*s.y,std::abs(u.y)*s.x+std::abs(u.x)*s.y);
+            }
+
+            //Get the size along the axes of the rectangle
+            Vct get_side () const
+            {
+                return s;
             }
 
         /*Set*/
@@ -309,13 +1562,61 @@ namespace fdx { namespace arrow
             //Set the size of the circle that contains the shape completly
             void set_size (Vct::Mod nsize)
             {
-                s=nsize;
+                s=Vct(2*nsize,2*nsize);
+                touch();
             }
 
-            //Set the size (diagonal) of the rectangle that contains the shape completly
-            void set_diagonal (const Vct &ndiag)
+            //Set the size (diagonal) of the rectangle that contains the shape completly (scales the rectangle to fit in it)
+            void set_diagonal (const Vct &ndiag);
+
+            //Set the size along the axes of the rectangle
+            void set_side (const Vct &nside)
             {
-                s=std::min(ndiag.x,ndiag.y);
+                s=nside;
+                touch();
+            }
+
+        /* Orientation */
+
+        public:
+
+            //Get the unitary X axis of the rectangle
+            Vct get_axis_x () const
+            {
+                return u;
+            }
+
+            //Get the unitary Y axis of the rectangle
+            Vct get_axis_y () const
+            {
+                return Vct(-u.y,u.x);
+            }
+
+            //Get the angle of the X axis of the rectangle
+            Vct::Mod get_angle () const
+            {
+                return u.angle();
+            }
+
+            //Set the angle of the X axis of the rectangle
+            void set_angle (Vct::Mod nangle)
+            {
+                u=Vct::mk_ang_mod(nangle,1);
+                touch();
+            }
+
+            //Set the unitary X axis of the rectangle (the vector is made unitary)
+            void set_axis_x (const Vct &naxis)
+            {
+                u=naxis;
+                u.unitary();
+                touch();
+            }
+
+            //Rotate the rectangle around its center
+            void rot (Vct::Mod nangle)
+            {
+                set_angle(get_angle()+nangle);
             }
 
         /* Move */
@@ -326,6 +1627,7 @@ namespace fdx { namespace arrow
             void mov (const Vct &m)
             {
                 r+=m;
+                touch();
             }
 
         /* Contact */
@@ -344,6 +1646,22 @@ namespace fdx { namespace arrow
             //Contact with a rectangle
             bool contact (const Rct &r) const;
 
+            //Contact with an oriented rectangle
+            bool contact (const Obb &o) const;
+
+            //Contact with a convex polygon
+            bool contact (const Pol &p) const;
+
+            //Contact with a capsule
+            bool contact (const Cap &c) const;
+
+        /* Distance */
+
+        public:
+
+            //Squared distance from a point to the surface of the shape (0 if the point is inside)
+            Vct::Mod sq_dist (const Vct &p) const;
+
         /* Time to hit */
 
         public:
@@ -360,6 +1678,40 @@ namespace fdx { namespace arrow
             //TTH a rectangle at a given speed
             Vct::Mod tth (const Rct &r, const Vct &speed) const;
 
+            //TTH an oriented rectangle at a given speed
+            Vct::Mod tth (const Obb &o, const Vct &speed) const;
+
+            //TTH a convex polygon at a given speed
+            Vct::Mod tth (const Pol &p, const Vct &speed) const;
+
+            //TTH a capsule at a given speed
+            Vct::Mod tth (const Cap &c, const Vct &speed) const;
+
+        /* Time of impact */
+
+        public:
+
+            //TOI a generic shape at a given speed
+            Toi toi (const Shp &s, const Vct &speed) const;
+
+            //TOI a circle at a given speed
+            Toi toi (const Crl &c, const Vct &speed) const;
+
+            //TOI a point at a given speed
+            Toi toi (const Pnt &p, const Vct &speed) const;
+
+            //TOI a rectangle at a given speed
+            Toi toi (const Rct &r, const Vct &speed) const;
+
+            //TOI an oriented rectangle at a given speed
+            Toi toi (const Obb &o, const Vct &speed) const;
+
+            //TOI a convex polygon at a given speed
+            Toi toi (const Pol &p, const Vct &speed) const;
+
+            //TOI a capsule at a given speed
+            Toi toi (const Cap &c, const Vct &speed) const;
+
         /* Movement against a shape */
 
         public:
@@ -375,10 +1727,21 @@ namespace fdx { namespace arrow
 
             //Movement against a rectangle at a given speed
             Vct mov_against (const Rct &r, const Vct &speed) const;
+
+            //Movement against an oriented rectangle at a given speed
+            Vct mov_against (const Obb &o, const Vct &speed) const;
+
+            //Movement against a convex polygon at a given speed
+            Vct mov_against (const Pol &p, const Vct &speed) const;
+
+            //Movement against a capsule at a given speed
+            Vct mov_against (const Cap &c, const Vct &speed) const;
     };
 
-    //Point
-    class Pnt : public Shp
+    /*Convex polygon
+      The vertices are kept relative to the center (centroid) in counter clockwise order, with their coordinates in separate arrays,
+      together with the unitary outer normal of each side (from a vertex to the next one), so moving the polygon only moves its center*/
+    class Pol : public Shp
     {
         /* Attributes */
 
@@ -386,7 +1749,19 @@ namespace fdx { namespace arrow
 
         private:
 
-            Vct r;//Point position
+            Vct r;//Center of the polygon
+
+        /*Vertices*/
+
+        private:
+
+            std::vector<Vct::Coord> px, py;//Vertices, relative to the center
+
+            std::vector<Vct::Coord> nx, ny;//Unitary outer normal of each side
+
+            Vct lo, hi;//Corners of the rectangle that contains the vertices, relative to the center
+
+            Vct::Mod rad;//Greatest distance from the center to a vertex
 
         /* Constructors, copy control */
 
@@ -394,26 +1769,81 @@ namespace fdx { namespace arrow
 
         public:
 
-            //Default constructor
-            Pnt() = default;
-
-            //Complete constructor
-            Pnt (const Vct &nr)
-            :r(nr)
+            //Default constructor (no vertices, in contact with nothing)
+            Pol()
+            :rad(0)
             {}
 
+            //Constructor from the vertices (a convex polygon, in any order of rotation)
+            explicit Pol (const std::vector<Vct> &nvert)
+            {
+                set_vertices(nvert);
+            }
+
+            //Constructor from a rectangle
+            explicit Pol (const Rct &nrct);
+
+            //Constructor from an oriented rectangle
+            explicit Pol (const Obb &nobb);
+
             //Default copy constructor
-            Pnt (const Pnt &) = default;
+            Pol (const Pol&) = default;
 
         /*Copy control*/
 
         public:
 
             //Default copy operator
-            Pnt& operator= (const Pnt &) = default;
+            Pol& operator= (const Pol &) = default;
 
             //Destructor
-            virtual ~Pnt() {}
+            virtual ~Pol() {}
+
+        /* Type */
+
+        public:
+
+            //Get the type of the shape
+            Tag get_tag () const
+            {
+                return Tag::pol;
+            }
+
+        /* Vertices */
+
+        public:
+
+            //Set the vertices (a convex polygon, in any order of rotation), the center is moved to their centroid
+            void set_vertices (const std::vector<Vct> &nvert);
+
+            //Get the number of vertices (and sides)
+            std::size_t get_count () const
+            {
+                return px.size();
+            }
+
+            //Get a vertex
+            Vct get_vertex (std::size_t i) const
+            {
+                return r+Vct(px[i],py[i]);
+            }
+
+            //Get the unitary outer normal of the side from a vertex to the next one
+            Vct get_normal (std::size_t i) const
+            {
+                return Vct(nx[i],ny[i]);
+            }
+
+            //Columns of the vertices (relative to the center) and normals
+            const Vct::Coord* vertex_x() const {return px.data();}
+            const Vct::Coord* vertex_y() const {return py.data();}
+            const Vct::Coord* normal_x() const {return nx.data();}
+            const Vct::Coord* normal_y() const {return ny.data();}
+
+        private:
+
+            //Scale the polygon from its center
+            void scale (Vct::Mod k);
 
         /* Position */
 
@@ -430,7 +1860,7 @@ namespace fdx { namespace arrow
             //Get the upper left corner of the rectangle that contains the shape completly
             Vct get_pos_corner () const
             {
-                return r;
+                return r+lo;
             }
 
         /*Set*/
@@ -441,12 +1871,14 @@ namespace fdx { namespace arrow
             void set_pos_center (const Vct &ncenter)
             {
                 r=ncenter;
+                touch();
             }
 
             //Set the upper left corner of the rectangle that contains the shape completly
             void set_pos_corner (const Vct &ncorner)
             {
-                r=ncorner;
+                r=ncorner-lo;
+                touch();
             }
 
         /* Size */
@@ -458,29 +1890,32 @@ namespace fdx { namespace arrow
             //Get the size of the circle that contains the shape completly
             Vct::Mod get_size () const
             {
-                return 0;
+                return rad;
             }
 
             //Get the size (diagonal) of the rectangle that contains the shape completly
             Vct get_diagonal () const
             {
-                return Vct(0,0);
+                return hi-lo;
             }
 
         /*Set*/
 
         public:
 
-            //Set the size of the circle that contains the shape completly
-            void set_size (Vct::Mod)
+            //Set the size of the circle that contains the shape completly (scales the polygon)
+            void set_size (Vct::Mod nsize)
             {
-                return;//This function does nothing on a point
+                if (rad>0)
+                    scale(nsize/rad);
             }
 
-            //Set the size (diagonal) of the rectangle that contains the shape completly
-            void set_diagonal (const Vct &)
+            //Set the size (diagonal) of the rectangle that contains the shape completly (scales the polygon to fit in it)
+            void set_diagonal (const Vct &ndiag)
             {
-                return;//This function does nothing on a point
+                Vct d(get_diagonal());
+                if (d.x>0&&d.y>0)
+                    scale(std::min(ndiag.x/d.x,ndiag.y/d.y));
             }
 
         /* Move */
@@ -491,6 +1926,7 @@ namespace fdx { namespace arrow
             void mov (const Vct &m)
             {
                 r+=m;
+                touch();
             }
 
         /* Contact */
@@ -509,6 +1945,22 @@ namespace fdx { namespace arrow
             //Contact with a rectangle
             bool contact (const Rct &r) const;
 
+            //Contact with an oriented rectangle
+            bool contact (const Obb &o) const;
+
+            //Contact with a convex polygon
+            bool contact (const Pol &p) const;
+
+            //Contact with a capsule
+            bool contact (const Cap &c) const;
+
+        /* Distance */
+
+        public:
+
+            //Squared distance from a point to the surface of the shape (0 if the point is inside)
+            Vct::Mod sq_dist (const Vct &p) const;
+
         /* Time to hit */
 
         public:
@@ -525,6 +1977,40 @@ namespace fdx { namespace arrow
             //TTH a rectangle at a given speed
             Vct::Mod tth (const Rct &r, const Vct &speed) const;
 
+            //TTH an oriented rectangle at a given speed
+            Vct::Mod tth (const Obb &o, const Vct &speed) const;
+
+            //TTH a convex polygon at a given speed
+            Vct::Mod tth (const Pol &p, const Vct &speed) const;
+
+            //TTH a capsule at a given speed
+            Vct::Mod tth (const Cap &c, const Vct &speed) const;
+
+        /* Time of impact */
+
+        public:
+
+            //TOI a generic shape at a given speed
+            Toi toi (const Shp &s, const Vct &speed) const;
+
+            //TOI a circle at a given speed
+            Toi toi (const Crl &c, const Vct &speed) const;
+
+            //TOI a point at a given speed
+            Toi toi (const Pnt &p, const Vct &speed) const;
+
+            //TOI a rectangle at a given speed
+            Toi toi (const Rct &r, const Vct &speed) const;
+
+            //TOI an oriented rectangle at a given speed
+            Toi toi (const Obb &o, const Vct &speed) const;
+
+            //TOI a convex polygon at a given speed
+            Toi toi (const Pol &p, const Vct &speed) const;
+
+            //TOI a capsule at a given speed
+            Toi toi (const Cap &c, const Vct &speed) const;
+
         /* Movement against a shape */
 
         public:
@@ -540,10 +2026,19 @@ namespace fdx { namespace arrow
 
             //Movement against a rectangle at a given speed
             Vct mov_against (const Rct &r, const Vct &speed) const;
+
+            //Movement against an oriented rectangle at a given speed
+            Vct mov_against (const Obb &o, const Vct &speed) const;
+
+            //Movement against a convex polygon at a given speed
+            Vct mov_against (const Pol &p, const Vct &speed) const;
+
+            //Movement against a capsule at a given speed
+            Vct mov_against (const Cap &c, const Vct &speed) const;
     };
 
-    //Rectangle
-    class Rct : public Shp
+    //Capsule, a segment rounded by a radius
+    class Cap : public Shp
     {
         /* Attributes */
 
@@ -551,9 +2046,17 @@ namespace fdx { namespace arrow
 
         private:
 
-            Vct r;//Upper left corner position
+            Vct r;//Center of the segment
 
-            Vct s;//Size, from the upper left corner to the opposite corner
+            Vct u;//Unitary axis of the segment
+
+        /*Size*/
+
+        private:
+
+            Vct::Mod l;//Half length of the segment
+
+            Vct::Mod s;//Radius
 
         /* Constructors, copy control */
 
@@ -562,25 +2065,87 @@ namespace fdx { namespace arrow
         public:
 
             //Default constructor
-            Rct() = default;
-
-            //Complete constructor
-            Rct (const Vct &nr, const Vct &ns)
-            :r(nr), s(ns)
+            Cap()
+            :u(1,0), l(0), s(0)
             {}
 
+            //Complete constructor, from the ends of the segment and the radius
+            Cap (const Vct &na, const Vct &nb, Vct::Mod ns)
+            :s(ns)
+            {
+                set_ends(na,nb);
+            }
+
             //Default copy constructor
-            Rct (const Rct&) = default;
+            Cap (const Cap&) = default;
 
         /*Copy control*/
 
         public:
 
-            //Default copy constructor
-            Rct& operator= (const Rct &) = default;
+            //Default copy operator
+            Cap& operator= (const Cap &) = default;
 
             //Destructor
-            virtual ~Rct() {}
+            virtual ~Cap() {}
+
+        /* Type */
+
+        public:
+
+            //Get the type of the shape
+            Tag get_tag () const
+            {
+                return Tag::cap;
+            }
+
+        /* Segment */
+
+        public:
+
+            //Get the first end of the segment
+            Vct get_end_a () const
+            {
+                return r-u*l;
+            }
+
+            //Get the second end of the segment
+            Vct get_end_b () const
+            {
+                return r+u*l;
+            }
+
+            //Set the ends of the segment
+            void set_ends (const Vct &na, const Vct &nb)
+            {
+                r=0.5*(na+nb);
+                u=nb-na;
+                l=0.5*u.mod();
+                if (l>0)
+                    u.unitary();
+                else
+                    u=Vct(1,0);
+                touch();
+            }
+
+            //Get the unitary axis of the segment
+            Vct get_axis_x () const
+            {
+                return u;
+            }
+
+            //Get the radius
+            Vct::Mod get_radius () const
+            {
+                return s;
+            }
+
+            //Set the radius
+            void set_radius (Vct::Mod nradius)
+            {
+                s=nradius;
+                touch();
+            }
 
         /* Position */
 
@@ -591,13 +2156,13 @@ namespace fdx { namespace arrow
             //Get the center of the shape
             Vct get_pos_center () const
             {
-                return r+0.5*s;
+                return r;
             }
 
             //Get the upper left corner of the rectangle that contains the shape completly
             Vct get_pos_corner () const
             {
-                return r;
+                return r-0.5*get_diagonal();
             }
 
         /*Set*/
@@ -607,13 +2172,15 @@ namespace fdx { namespace arrow
             //Set the center of the shape
             void set_pos_center (const Vct &ncenter)
             {
-                r=ncenter-0.5*s;
+                r=ncenter;
+                touch();
             }
 
             //Set the upper left corner of the rectangle that contains the shape completly
             void set_pos_corner (const Vct &ncorner)
             {
-                r=ncorner;
+                r=ncorner+0.5*get_diagonal();
+                touch();
             }
 
         /* Size */
@@ -625,30 +2192,24 @@ namespace fdx { namespace arrow
             //Get the size of the circle that contains the shape completly
             Vct::Mod get_size () const
             {
-                return 0.5*s.mod();
+                return l+s;
             }
 
             //Get the size (diagonal) of the rectangle that contains the shape completly
             Vct get_diagonal () const
             {
-                return s;
+                return Vct(2*(std::abs(u.x)*l+s),2*(std::abs(u.y)*l+s));
             }
 
         /*Set*/
 
         public:
 
-            //Set the size of the circle that contains the shape completly
-            void set_size (Vct::Mod nsize)
-            {
-                s=Vct(2*nsize,2*nsize);
-            }
+            //Set the size of the circle that contains the shape completly (scales the capsule)
+            void set_size (Vct::Mod nsize);
 
-            //Set the size (diagonal) of the rectangle that contains the shape completly
-            void set_diagonal (const Vct &ndiag)
-            {
-                s=ndiag;
-            }
+            //Set the size (diagonal) of the rectangle that contains the shape completly (scales the capsule to fit in it)
+            void set_diagonal (const Vct &ndiag);
 
         /* Move */
 
@@ -658,6 +2219,7 @@ namespace fdx { namespace arrow
             void mov (const Vct &m)
             {
                 r+=m;
+                touch();
             }
 
         /* Contact */
@@ -676,6 +2238,21 @@ namespace fdx { namespace arrow
             //Contact with a rectangle
             bool contact (const Rct &r) const;
 
+            //Contact with an oriented rectangle
+            bool contact (const Obb &o) const;
+
+            //Contact with a convex polygon
+            bool contact (const Pol &p) const;
+
+            //Contact with a capsule
+            bool contact (const Cap &c) const;
+
+        /* Distance */
+
+        public:
+
+            //Squared distance from a point to the surface of the shape (0 if the point is inside)
+            Vct::Mod sq_dist (const Vct &p) const;
 
         /* Time to hit */
 
@@ -690,212 +2267,140 @@ namespace fdx { namespace arrow
             //TTH a point at a given speed
             Vct::Mod tth (const Pnt &p, const Vct &speed) const;
 
-            //TTH a point at a given speed
+            //TTH a rectangle at a given speed
             Vct::Mod tth (const Rct &r, const Vct &speed) const;
 
-        /* Movement against a shape */
-
-        public:
-
-            //Movement against a generic shape at a given speed
-            Vct mov_against (const Shp &s, const Vct &speed) const;
-
-            //Movement against a circle at a given speed
-            Vct mov_against (const Crl &c, const Vct &speed) const;
-
-            //Movement against a point at a given speed
-            Vct mov_against (const Pnt &p, const Vct &speed) const;
-
-            //Movement against a point at a given speed
-            Vct mov_against (const Rct &r, const Vct &speed) const;
-
-    };
-
-    //Set of real values with two limits
-    class Set
-    {
-        /* Configuration */
-
-        /*Data types*/
-        public:
-
-            //Type of limits
-            typedef double Limit;
-
-            //Type of values
-            typedef double Value;
-
-        /*Constants*/
-        private:
-
-            static constexpr Limit DEF_MIN_LIMIT=0,DEF_MAX_LIMIT=0;//Default set
-            static constexpr Limit DEF_MIN_NULL=0,DEF_MAX_NULL=-1;//Default null set (holds no values)
-
-        /* Attributes */
-
-        /*Limits*/
-        private:
-
-            Limit min_limit, max_limit;
-
-        /* Limit members */
+            //TTH an oriented rectangle at a given speed
+            Vct::Mod tth (const Obb &o, const Vct &speed) const;
 
-        /*Validity*/
-        public:
+            //TTH a convex polygon at a given speed
+            Vct::Mod tth (const Pol &p, const Vct &speed) const;
 
-            //Check for validity of the set
-            bool valid() const
-            {
-                return min_limit<=max_limit;
-            }
+            //TTH a capsule at a given speed
+            Vct::Mod tth (const Cap &c, const Vct &speed) const;
 
-            //Swap the limit
-            void swap_limits()
-            {
-                Limit temp=min_limit;
-                min_limit=max_limit;
-                max_limit=temp;
-            }
+        /* Time of impact */
 
-        /*Set/get*/
         public:
 
-            //Set limit
-
-            void set_min(Limit il)
-            {
-                min_limit=il;
-            }
+            //TOI a generic shape at a given speed
+            Toi toi (const Shp &s, const Vct &speed) const;
 
-            void set_max(Limit il)
-            {
-                max_limit=il;
-            }
+            //TOI a circle at a given speed
+            Toi toi (const Crl &c, const Vct &speed) const;
 
-            //Safe set (swaps limits if necessary)
+            //TOI a point at a given speed
+            Toi toi (const Pnt &p, const Vct &speed) const;
 
-            void set_safe_min(Limit il)
-            {
-                set_min(il);
-                if (!valid())
-                    swap_limits();
-            }
+            //TOI a rectangle at a given speed
+            Toi toi (const Rct &r, const Vct &speed) const;
 
-            void set_safe_max(Limit il)
-            {
-                set_max(il);
-                if (!valid())
-                    swap_limits();
-            }
+            //TOI an oriented rectangle at a given speed
+            Toi toi (const Obb &o, const Vct &speed) const;
 
-            //Get limits
+            //TOI a convex polygon at a given speed
+            Toi toi (const Pol &p, const Vct &speed) const;
 
-            Limit get_min() const
-            {
-                return min_limit;
-            }
+            //TOI a capsule at a given speed
+            Toi toi (const Cap &c, const Vct &speed) const;
 
-            Limit get_max() const
-            {
-                return max_limit;
-            }
+        /* Movement against a shape */
 
-        /*Values*/
         public:
 
-            //Check if a value is in the set
-            bool check_value(Value v) const
-            {
-                return(min_limit<=v&&v<=max_limit);
-            }
+            //Movement against a generic shape at a given speed
+            Vct mov_against (const Shp &s, const Vct &speed) const;
 
-        /*Size*/
-        public:
+            //Movement against a circle at a given speed
+            Vct mov_against (const Crl &c, const Vct &speed) const;
 
-            //Get the size
-            Limit get_size() const
-            {
-                return max_limit-min_limit;
-            }
+            //Movement against a point at a given speed
+            Vct mov_against (const Pnt &p, const Vct &speed) const;
 
-            //Is elemental
-            bool elemental() const
-            {
-                return min_limit==max_limit;
-            }
+            //Movement against a rectangle at a given speed
+            Vct mov_against (const Rct &r, const Vct &speed) const;
 
-            //Get the center
-            Limit get_middle() const
-            {
-                return (min_limit+max_limit)/2.0;
-            }
+            //Movement against an oriented rectangle at a given speed
+            Vct mov_against (const Obb &o, const Vct &speed) const;
 
-        /* Constructors, copy control */
+            //Movement against a convex polygon at a given speed
+            Vct mov_against (const Pol &p, const Vct &speed) const;
 
-        /*Constructors*/
-        public:
+            //Movement against a capsule at a given speed
+            Vct mov_against (const Cap &c, const Vct &speed) const;
+    };
 
-            //Complete constructor
-            Set(Limit imin, Limit imax)
-            :min_limit(imin),max_limit(imax)
-            {}
+    /*
+        Functions
+    */
 
-            //Default constructor
-            Set()
-            :Set(DEF_MIN_LIMIT,DEF_MAX_LIMIT)
-            {}
+    /* Sets */
 
-            //Copy constructor
-            Set(const Set& s)
-            :Set(s.min_limit,s.max_limit)
-            {}
+    //Times in which the first set, moving at the given speed, overlaps the second (all the times if static and overlapping)
+    constexpr Set tth_set_set (const Set &s1, const Set &s2, Set::Value speed)
+    {
+        //Moving sets, the time is limited
+        if (speed)
+            return s1.tth(s2,speed);
 
-        /*Operators*/
-        public:
+        //Static sets, they overlap always or never
+        if (s1.get_min()<=s2.get_max()&&s2.get_min()<=s1.get_max())
+            return Set(-std::numeric_limits<Set::Limit>::infinity(),std::numeric_limits<Set::Limit>::infinity());
+        return Set(0,-1);
+    }
 
-            //Assignment operator
-            Set& operator= (const Set& s)
-            {
-                min_limit=s.min_limit;
-                max_limit=s.max_limit;
-                return *this;
-            }
+    /* Box */
 
-            //Mulitply and assign operator
-            void operator*= (Limit m)
-            {
-                min_limit*=m;
-                max_limit*=m;
-                if (m<0)
-                    swap_limits();
-            }
+    //Times in which this box, moving at the given speed, overlaps another box
+    constexpr Set Box::tth(const Box &b, const Vct &speed) const
+    {
+        return Set::min_intersect(tth_set_set(x,b.x,speed.x),tth_set_set(y,b.y,speed.y));
+    }
 
-        /* Set methods */
+    /* Contact
+       The shape functions use these with their centers and sizes, they can be evaluated at compile time */
 
-        /*Intersect*/
-        public:
+    //Contact between two circles or points (radius 0) given by their centers and radii
+    constexpr bool contact_crlpnt_crlpnt (const Vct &c1, Vct::Mod s1, const Vct &c2, Vct::Mod s2)
+    {
+        Vct::Mod dist=s1+s2;//Size of the shapes (radius for Crl, 0 for Pnt)
+        return ((c1-c2).sq_mod())<(dist*dist);//If the distance between centers is less than the size, the shapes are in contact
+    }
 
-            //Return the intersection of two sets
-            static Set min_intersect(const Set& s1, const Set& s2)
-            {
-                return Set(std::max(s1.get_min(),s2.get_min()),std::min(s1.get_max(),s2.get_max()));
-            }
+    //Get the minimum absolute value of a set
+    constexpr Vct::Mod min_abs_set (Vct::Mod min_set, Vct::Mod max_set)
+    {
+        //If 0 is on the set, it will always be the minimum
+        if (min_set<=0&&0<=max_set)//0 is on the set, return it
+            return 0;
+        else//0 is not in the set, the min abs value is one of the extremes
+            return min_set>0?min_set:-max_set;
+    }
+
+    //Contact between a circle or point (radius 0) and a rectangle given by its upper left corner and diagonal
+    constexpr bool contact_crlpnt_rct (const Vct &c, Vct::Mod s, const Vct &corner, const Vct &diag)
+    {
+        //Get the distance between the shapes
+        Vct d(corner-c);
 
-            //Returns the big union of two sets (no gaps)
-            static Set max_union(const Set &s1, const Set& s2)
-            {
-                return Set(std::min(s1.get_min(),s2.get_min()),std::max(s1.get_max(),s2.get_max()));
-            }
+        //Get the minium distance between vector between the shapes
+        Vct m(min_abs_set(d.x,d.x+diag.x),min_abs_set(d.y,d.y+diag.y));
+        return m.sq_mod()<=s*s;
+    }
 
-        /*TTH*/
-        public:
+    //Contact between two rectangles given by their centers and diagonals
+    constexpr bool contact_rct_rct (const Vct &c1, const Vct &d1, const Vct &c2, const Vct &d2)
+    {
+        //Distance between the centers
+        Vct rdist(c1-c2);
 
-            //TTH a point
-            Set tth(Value v, Value speed) const;
+        //Size of the two rectangles combined
+        Vct rsz(d1+d2);
+        rsz*=(0.5f);//Get the half size, not the full size
 
-            //TTH a set
-            Set tth(const Set& s, Value speed) const;
-    };
+        //Check for contact (size is less than the distance)
+        return ((rdist.x<0?-rdist.x:rdist.x)<=rsz.x)&&((rdist.y<0?-rdist.y:rdist.y)<=rsz.y);
+    }
 
 }}//End of namespace
 
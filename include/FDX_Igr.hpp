@@ -0,0 +1,210 @@
+/*
+ * FDX_Igr.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Igr
+    Batched integration of positions and speeds
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_IGR_H_
+#define _FDX_IGR_H_
+
+
+/* Includes */
+
+//Arrays of vectors
+#include "FDX_Vca.hpp"
+
+//Bodies
+#include "FDX_Bdy.hpp"
+
+//Broadphase
+#include "FDX_Bvh.hpp"
+
+//Workers of the other threads
+#include "FDX_Wrk.hpp"
+
+//Boxes of the bodies
+#include <vector>
+
+//No limit of speed
+#include <limits>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    /*Integrator, moves many bodies at once over their columns of positions, speeds and accelerations
+      The loops are branchless so they are vectorized, big batches are split between the caller and the workers of a pool
+      (a step waits for its ranges, it must not be run by a task of the same pool).
+      The accelerations are constant during a step, the speeds can be limited (as Vct::limmod does)*/
+    class Igr
+    {
+        /* Types and constants */
+
+        public:
+
+            //Type of the coordinates
+            typedef Vct::Coord Coord;
+            //Type of the modules and times
+            typedef Vct::Mod Mod;
+
+            //Method of integration
+            enum class Method
+            {
+                euler,//Explicit Euler: the position moves with the speed before the step
+                semi_euler,//Semi-implicit (symplectic) Euler: the position moves with the speed after the step
+                verlet//Velocity Verlet: the position moves with the mean speed of the step
+            };
+
+            //Smallest number of bodies given to a thread
+            static constexpr std::size_t MIN_CHUNK=4096;
+
+        /* Attributes */
+
+        private:
+
+            Method method;//Method of integration
+
+            Mod max_speed;//Greatest module of the speeds (infinite if they are not limited)
+
+            unsigned threads;//Number of threads used (the caller is one of them)
+
+            Wrk *pool;//Pool that runs the ranges of the other threads (the shared pool if null)
+
+            std::vector<Box> boxes;//Boxes of the bodies after the last step of a store
+
+        /* Constructors */
+
+        public:
+
+            //Constructor with the method, limit of the speeds and threads
+            explicit Igr (Method nmethod=Method::semi_euler, Mod nmax_speed=std::numeric_limits<Mod>::infinity(), unsigned nthreads=1)
+            :method(nmethod), max_speed(nmax_speed), threads(nthreads?nthreads:1), pool(nullptr)
+            {}
+
+        /* Access methods */
+
+        public:
+
+            //Get the method of integration
+            Method get_method() const
+            {
+                return method;
+            }
+
+            //Set the method of integration
+            void set_method (Method nmethod)
+            {
+                method=nmethod;
+            }
+
+            //Get the greatest module of the speeds
+            Mod get_max_speed() const
+            {
+                return max_speed;
+            }
+
+            //Set the greatest module of the speeds (not negative, infinite to not limit them)
+            void set_max_speed (Mod nmax_speed)
+            {
+                max_speed=nmax_speed;
+            }
+
+            //Get the number of threads
+            unsigned get_threads() const
+            {
+                return threads;
+            }
+
+            //Set the number of threads (0 is the same as 1, only the caller)
+            void set_threads (unsigned nthreads)
+            {
+                threads=nthreads?nthreads:1;
+            }
+
+            //Get the pool that runs the ranges of the other threads (null for the shared pool)
+            Wrk* get_pool() const
+            {
+                return pool;
+            }
+
+            //Set the pool that runs the ranges of the other threads (null for the shared pool)
+            void set_pool (Wrk *npool)
+            {
+                pool=npool;
+            }
+
+            //Get the boxes of the bodies after the last step of a store (indexed by the dense index)
+            const std::vector<Box>& get_boxes() const
+            {
+                return boxes;
+            }
+
+        /* Steps */
+
+        public:
+
+            /*Integrate the positions and speeds during dt with the given accelerations
+              The arrays must have the same size, the accelerations can be empty (no acceleration)*/
+            void step (Vca &pos, Vca &spd, const Vca &acc, Mod dt) const;
+
+            /*Integrate the bodies of a store during dt with the given accelerations (indexed by the dense index, can be empty)
+              The boxes of the bodies are computed in the same pass and given to the hierarchy if it's not null:
+              it's refit, or built if the number of bodies changed*/
+            void step (Bdy_store &s, const Vca &acc, Mod dt, Bvh *bvh=nullptr);
+
+        private:
+
+            //Integrate the bodies in [first,last)
+            void step_range (Vca &pos, Vca &spd, const Vca &acc, Mod dt, std::size_t first, std::size_t last) const;
+
+            //Call f(first,last) over the ranges of [0,n) given to each thread
+            template <class F>
+            void split (std::size_t n, F f) const;
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_IGR_H_
@@ -0,0 +1,209 @@
+/*
+ * FDX_Itv.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Itv
+    Index of intervals (sets) for 1D queries
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_ITV_H_
+#define _FDX_ITV_H_
+
+
+/* Includes */
+
+//Sets
+#include "FDX_Geo.hpp"
+
+//Fixed size integers
+#include <cstdint>
+
+//Columns
+#include <vector>
+
+//Min, max
+#include <algorithm>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    /*Index of intervals (sets) for stabbing, overlap and TTH queries
+      The sets are sorted by their minimum and seen as an implicit balanced tree (the middle of a range is its root),
+      each node keeps the greatest maximum of its subtree, so queries visit O(log n + k) nodes.
+      Sets are added and then the index is built, queries give the id of the set (order in which it was added)*/
+    class Itv
+    {
+        /* Types and constants */
+
+        public:
+
+            //Type of limits and values
+            typedef Set::Limit Limit;
+            typedef Set::Value Value;
+
+            //Id of a set
+            typedef std::uint32_t Id;
+
+        /* Attributes */
+
+        private:
+
+            std::vector<Set> pending;//Sets added, in order of their id
+
+            std::vector<Limit> mins, maxs;//Limits of the sets, sorted by the minimum
+
+            std::vector<Limit> sub_max;//Greatest maximum of the subtree of each node
+
+            std::vector<Id> ids;//Id of each sorted set
+
+        /* Sets */
+
+        public:
+
+            //Add a set (not valid sets are never found), returns its id
+            Id add (const Set &s)
+            {
+                pending.push_back(s);
+                return static_cast<Id>(pending.size()-1);
+            }
+
+            //Get a set
+            const Set& get (Id id) const
+            {
+                return pending[id];
+            }
+
+            //Number of sets
+            std::size_t size() const
+            {
+                return pending.size();
+            }
+
+            //Remove every set
+            void clear();
+
+            //Build the index over the sets added
+            void build();
+
+        private:
+
+            //Greatest maximum of the range [lo,hi), stored in its middle
+            Limit build_node (std::size_t lo, std::size_t hi);
+
+        /* Queries */
+
+        public:
+
+            /*Call f(id) for every set that contains the value
+              If f returns false the query stops, the function returns false in that case*/
+            template <class F>
+            bool stab (Value v, F f) const
+            {
+                return overlap(Set(v,v),f);
+            }
+
+            //Call f(id) for every set that overlaps the given set (limits included)
+            template <class F>
+            bool overlap (const Set &s, F f) const
+            {
+                //Ranges of the implicit tree to visit
+                struct Range
+                {
+                    std::size_t lo, hi;
+                };
+                Range stack[128];
+                int top=0;
+                if (!mins.empty())
+                    stack[top++]=Range{0,mins.size()};
+
+                while (top)
+                {
+                    Range r=stack[--top];
+                    std::size_t mid=r.lo+(r.hi-r.lo)/2;
+
+                    //No set of the subtree reaches the query
+                    if (sub_max[mid]<s.get_min())
+                        continue;
+
+                    //Left subtree
+                    if (r.lo<mid)
+                        stack[top++]=Range{r.lo,mid};
+
+                    //The sets from the middle start after the query
+                    if (mins[mid]>s.get_max())
+                        continue;
+
+                    if (maxs[mid]>=s.get_min())
+                        if (!f(ids[mid]))
+                            return false;
+
+                    //Right subtree
+                    if (mid+1<r.hi)
+                        stack[top++]=Range{mid+1,r.hi};
+                }
+                return true;
+            }
+
+            //TTH of a set moving at the given speed against every set, out[id] gets the times of contact
+            void tth (const Set &s, Value speed, Set *out) const;
+
+            /*Call f(id, times) for every set hit by a set moving at the given speed within [0,max_t]
+              times are the times of contact (Set::tth), only the sets swept by the moving set are visited*/
+            template <class F>
+            bool tth (const Set &s, Value speed, Value max_t, F f) const
+            {
+                //Values covered by the set while it moves
+                Value d=speed*max_t;
+                Set swept(s.get_min()+std::min(d,0.0),s.get_max()+std::max(d,0.0));
+                return overlap(swept,[this,&s,speed,&f](Id id)
+                {
+                    return static_cast<bool>(f(id,s.tth(pending[id],speed)));
+                });
+            }
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_ITV_H_
@@ -0,0 +1,361 @@
+/*
+ * FDX_Mem.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Mem
+    Pools of shapes (per type arenas with stable handles)
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_MEM_H_
+#define _FDX_MEM_H_
+
+
+/* Includes */
+
+//Shapes
+#include "FDX_Geo.hpp"
+
+//Fixed size integers
+#include <cstdint>
+
+//Chunks
+#include <vector>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    /*Pool of objects of a single type
+      Objects are constructed in chunks that are never moved, so pointers stay valid until the object
+      is released or the pool is reset. Released slots are reused by the next allocations, the generation
+      of the slot makes the handles of released objects invalid even if their slot is reused.
+      Not thread safe, each thread should own its pools*/
+    template <class T, std::size_t CHUNK=256>
+    class Pool
+    {
+        /* Types and constants */
+
+        public:
+
+            //Handle of an object, the slot and its generation when the object was added
+            struct Hdl
+            {
+                std::uint32_t index;//Slot of the object
+                std::uint32_t gen;//Generation of the slot
+
+                //Equality operator
+                bool operator== (const Hdl &h) const
+                {
+                    return index==h.index&&gen==h.gen;
+                }
+
+                //Inequality operator
+                bool operator!= (const Hdl &h) const
+                {
+                    return !(*this==h);
+                }
+            };
+
+            //Handle that refers to no object
+            static constexpr Hdl NULL_HDL={~std::uint32_t(0),0};
+
+        private:
+
+            //Raw storage of an object
+            typedef typename std::aligned_storage<sizeof(T),alignof(T)>::type Slot;
+
+            //End of the list of objects alive
+            static constexpr std::uint32_t NO_SLOT=~std::uint32_t(0);
+
+        /* Attributes */
+
+        private:
+
+            std::vector<std::unique_ptr<Slot[]>> chunks;//Storage, never moved
+
+            std::vector<bool> alive;//Slots holding an object
+
+            std::vector<std::uint32_t> gen;//Generation of each slot, kept by the resets
+
+            std::vector<std::uint32_t> next, prev;//List of the slots alive in allocation order
+
+            std::uint32_t first, last;//Ends of the list
+
+            std::vector<std::uint32_t> free_slots;//Released slots, reused first
+
+            std::uint32_t used;//Slots used since the last reset
+
+            std::size_t count;//Objects alive
+
+        /* Constructors, copy control */
+
+        public:
+
+            //Default constructor
+            Pool()
+            :first(NO_SLOT), last(NO_SLOT), used(0), count(0)
+            {}
+
+            //Pools own their objects, they can't be copied
+            Pool (const Pool &) = delete;
+            Pool& operator= (const Pool &) = delete;
+
+            //Destructor, destroys every object alive
+            ~Pool()
+            {
+                reset();
+            }
+
+        /* Slots */
+
+        private:
+
+            //Storage of a slot
+            Slot* slot (std::uint32_t i) const
+            {
+                return &chunks[i/CHUNK][i%CHUNK];
+            }
+
+            //Object of a slot
+            T* object (std::uint32_t i) const
+            {
+                return reinterpret_cast<T*>(slot(i));
+            }
+
+        /* Allocation */
+
+        public:
+
+            //Construct a new object with the given arguments, returns its handle
+            template <class... Args>
+            Hdl add (Args&&... args)
+            {
+                std::uint32_t i;
+                if (!free_slots.empty())//Reuse a released slot
+                {
+                    i=free_slots.back();
+                    free_slots.pop_back();
+                }
+                else//Use a new slot
+                {
+                    if (used==chunks.size()*CHUNK)
+                        chunks.emplace_back(new Slot[CHUNK]);
+                    alive.push_back(false);
+                    next.push_back(NO_SLOT);
+                    prev.push_back(NO_SLOT);
+                    if (used==gen.size())
+                        gen.push_back(0);
+                    i=used++;
+                }
+                new (slot(i)) T(std::forward<Args>(args)...);
+                alive[i]=true;
+                count++;
+
+                //Last in allocation order
+                prev[i]=last;
+                next[i]=NO_SLOT;
+                (last!=NO_SLOT?next[last]:first)=i;
+                last=i;
+                return Hdl{i,gen[i]};
+            }
+
+            //Destroy an object, its slot will be reused
+            void release (Hdl h)
+            {
+                if (!valid(h))
+                    return;
+                std::uint32_t i=h.index;
+                object(i)->~T();
+                alive[i]=false;
+                gen[i]++;
+                (prev[i]!=NO_SLOT?next[prev[i]]:first)=next[i];
+                (next[i]!=NO_SLOT?prev[next[i]]:last)=prev[i];
+                free_slots.push_back(i);
+                count--;
+            }
+
+            //Destroy every object at once, the chunks are kept for the next allocations
+            void reset()
+            {
+                for (std::uint32_t i=0;i<used;i++)
+                    if (alive[i])
+                    {
+                        object(i)->~T();
+                        gen[i]++;
+                    }
+                alive.clear();
+                next.clear();
+                prev.clear();
+                free_slots.clear();
+                first=last=NO_SLOT;
+                used=0;
+                count=0;
+            }
+
+        /* Access */
+
+        public:
+
+            //Check if a handle refers to an object alive
+            bool valid (Hdl h) const
+            {
+                return h.index<used&&alive[h.index]&&gen[h.index]==h.gen;
+            }
+
+            //Get an object, null if the handle is not valid
+            const T* get (Hdl h) const
+            {
+                return valid(h)?object(h.index):nullptr;
+            }
+
+            //Get an object, null if the handle is not valid
+            T* get (Hdl h)
+            {
+                return valid(h)?object(h.index):nullptr;
+            }
+
+            //Get an object (the handle must be valid)
+            const T& operator[] (Hdl h) const
+            {
+                return *object(h.index);
+            }
+
+            //Get an object (the handle must be valid)
+            T& operator[] (Hdl h)
+            {
+                return *object(h.index);
+            }
+
+            //Number of objects alive
+            std::size_t size() const
+            {
+                return count;
+            }
+
+        /* Iteration */
+
+        public:
+
+            //Call f(handle, object) for every object alive, in allocation order
+            template <class F>
+            void for_each (F f) const
+            {
+                for (std::uint32_t i=first;i!=NO_SLOT;i=next[i])
+                    f(Hdl{i,gen[i]},static_cast<const T&>(*object(i)));
+            }
+
+            //Call f(handle, object) for every object alive, in allocation order
+            template <class F>
+            void for_each (F f)
+            {
+                for (std::uint32_t i=first;i!=NO_SLOT;i=next[i])
+                    f(Hdl{i,gen[i]},*object(i));
+            }
+    };
+
+    template <class T, std::size_t CHUNK>
+    constexpr typename Pool<T,CHUNK>::Hdl Pool<T,CHUNK>::NULL_HDL;
+
+    template <class T, std::size_t CHUNK>
+    constexpr std::uint32_t Pool<T,CHUNK>::NO_SLOT;
+
+    //Pools of every type of shape
+    struct Shp_pools
+    {
+        Pool<Crl> crl;//Circles
+        Pool<Pnt> pnt;//Points
+        Pool<Rct> rct;//Rectangles
+        Pool<Obb> obb;//Oriented rectangles
+        Pool<Pol> pol;//Convex polygons
+        Pool<Cap> cap;//Capsules
+
+        //Destroy every shape at once
+        void reset()
+        {
+            crl.reset();
+            pnt.reset();
+            rct.reset();
+            obb.reset();
+            pol.reset();
+            cap.reset();
+        }
+
+        //Number of shapes alive
+        std::size_t size() const
+        {
+            return crl.size()+pnt.size()+rct.size()+obb.size()+pol.size()+cap.size();
+        }
+
+        //Call f(shape) for every shape alive, by type and in allocation order
+        template <class F>
+        void for_each (F f) const
+        {
+            crl.for_each([&f](Pool<Crl>::Hdl, const Crl &c){f(static_cast<const Shp&>(c));});
+            pnt.for_each([&f](Pool<Pnt>::Hdl, const Pnt &p){f(static_cast<const Shp&>(p));});
+            rct.for_each([&f](Pool<Rct>::Hdl, const Rct &r){f(static_cast<const Shp&>(r));});
+            obb.for_each([&f](Pool<Obb>::Hdl, const Obb &o){f(static_cast<const Shp&>(o));});
+            pol.for_each([&f](Pool<Pol>::Hdl, const Pol &p){f(static_cast<const Shp&>(p));});
+            cap.for_each([&f](Pool<Cap>::Hdl, const Cap &c){f(static_cast<const Shp&>(c));});
+        }
+
+        //Call f(shape) for every shape alive, by type and in allocation order
+        template <class F>
+        void for_each (F f)
+        {
+            crl.for_each([&f](Pool<Crl>::Hdl, Crl &c){f(static_cast<Shp&>(c));});
+            pnt.for_each([&f](Pool<Pnt>::Hdl, Pnt &p){f(static_cast<Shp&>(p));});
+            rct.for_each([&f](Pool<Rct>::Hdl, Rct &r){f(static_cast<Shp&>(r));});
+            obb.for_each([&f](Pool<Obb>::Hdl, Obb &o){f(static_cast<Shp&>(o));});
+            pol.for_each([&f](Pool<Pol>::Hdl, Pol &p){f(static_cast<Shp&>(p));});
+            cap.for_each([&f](Pool<Cap>::Hdl, Cap &c){f(static_cast<Shp&>(c));});
+        }
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_MEM_H_
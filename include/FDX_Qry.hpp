@@ -0,0 +1,227 @@
+/*
+ * FDX_Qry.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Qry
+    Batches of queries between shapes, run asynchronously on a pool of workers
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_QRY_H_
+#define _FDX_QRY_H_
+
+
+/* Includes */
+
+//Shapes
+#include "FDX_Geo.hpp"
+
+//Pool of workers
+#include "FDX_Wrk.hpp"
+
+//Fixed size integers
+#include <cstdint>
+
+//Columns
+#include <vector>
+
+//Asynchronous runs
+#include <future>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    /*Batch of independent queries between pairs of shapes (not owned)
+      The queries are grouped by their kind and the types of their shapes, every group runs a single kernel
+      without virtual calls. The groups are split in tasks of CHUNK queries that run on a pool of workers.
+      The batch and its shapes can't be changed while it runs, the results are read when it ends*/
+    class Qry
+    {
+        /* Types and constants */
+
+        public:
+
+            //Type of the times
+            typedef Vct::Mod Mod;
+
+            //Kind of query
+            enum class Kind : unsigned char
+            {
+                contact,//Contact between the shapes
+                tth,//Time for the first shape to hit the second
+                toi,//Time of impact with the data of the contact
+                mov_against//Movement of the first shape against the second
+            };
+
+            //Greatest number of queries in a task
+            static constexpr std::size_t CHUNK=256;
+
+        /* Attributes */
+
+        /*Columns of the queries*/
+
+        private:
+
+            std::vector<const Shp*> qa, qb;//Shapes of each query
+
+            std::vector<Vct> speed;//Speed of the first shape
+
+            std::vector<Kind> kind;//Kind of each query
+
+        /*Results (only the column of the kind of each query is written)*/
+
+        private:
+
+            std::vector<unsigned char> res_contact;//Contacts
+
+            std::vector<Mod> res_tth;//Times to hit
+
+            std::vector<Toi> res_toi;//Times of impact
+
+            std::vector<Vct> res_mov;//Movements
+
+        /*Groups*/
+
+        private:
+
+            std::vector<std::uint32_t> order;//Queries ordered by group
+
+            std::vector<std::uint32_t> tasks;//Start of each task in order (the last one is the end)
+
+        /* Queries */
+
+        public:
+
+            //Add a contact query, returns its index
+            std::size_t contact (const Shp &a, const Shp &b)
+            {
+                return push(Kind::contact,a,b,Vct());
+            }
+
+            //Add a TTH query, returns its index
+            std::size_t tth (const Shp &a, const Shp &b, const Vct &nspeed)
+            {
+                return push(Kind::tth,a,b,nspeed);
+            }
+
+            //Add a TOI query, returns its index
+            std::size_t toi (const Shp &a, const Shp &b, const Vct &nspeed)
+            {
+                return push(Kind::toi,a,b,nspeed);
+            }
+
+            //Add a movement query, returns its index
+            std::size_t mov_against (const Shp &a, const Shp &b, const Vct &nspeed)
+            {
+                return push(Kind::mov_against,a,b,nspeed);
+            }
+
+            //Number of queries
+            std::size_t size() const
+            {
+                return qa.size();
+            }
+
+            //Remove every query
+            void clear();
+
+        private:
+
+            //Add a query
+            std::size_t push (Kind k, const Shp &a, const Shp &b, const Vct &nspeed);
+
+        /* Runs */
+
+        public:
+
+            //Run every query on the calling thread
+            void run();
+
+            //Run the queries on a pool, the future is ready when every task has ended and rethrows the first exception of a task
+            std::future<void> run_async (Wrk &w=Wrk::shared());
+
+        private:
+
+            //Group the queries and split the groups in tasks
+            void group();
+
+            //Run the task t
+            void run_task (std::size_t t);
+
+            //Run the queries at the given indices, their kind and shapes are of the same types
+            template <class A, class B>
+            void kernel (Kind k, const std::uint32_t *idx, std::size_t n);
+
+        /* Results */
+
+        public:
+
+            //Result of a contact query
+            bool get_contact (std::size_t i) const
+            {
+                return res_contact[i];
+            }
+
+            //Result of a TTH query
+            Mod get_tth (std::size_t i) const
+            {
+                return res_tth[i];
+            }
+
+            //Result of a TOI query
+            const Toi& get_toi (std::size_t i) const
+            {
+                return res_toi[i];
+            }
+
+            //Result of a movement query
+            const Vct& get_mov_against (std::size_t i) const
+            {
+                return res_mov[i];
+            }
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_QRY_H_
@@ -0,0 +1,261 @@
+/*
+ * FDX_Scn.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Scn
+    Scene of shapes and queries over its bounding volume hierarchy
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_SCN_H_
+#define _FDX_SCN_H_
+
+
+/* Includes */
+
+//Shapes
+#include "FDX_Geo.hpp"
+
+//Acceleration structure
+#include "FDX_Bvh.hpp"
+
+//Fixed size integers
+#include <cstdint>
+
+//Shapes of the scene
+#include <vector>
+
+//Infinite distances
+#include <limits>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Class declarations
+    */
+
+    class Scn;//Scene
+
+    /*
+        Data types
+     */
+
+    /* Typedefs */
+
+    //Handle of a shape in a scene (order in which it was added)
+    typedef std::uint32_t Scn_hdl;
+
+    //Handle that refers to no shape
+    constexpr Scn_hdl NO_SHP=~Scn_hdl(0);
+
+    /* Classes */
+
+    //Ray, a point that moves from the origin along the direction until it has travelled the max length
+    struct Ray
+    {
+        Vct origin;//Origin of the ray
+        Vct dir;//Direction (module is ignored)
+        Vct::Mod max_len;//Length of the ray
+    };
+
+    //Result of a ray cast or a shape cast
+    struct Ray_hit
+    {
+        Scn_hdl shape;//Shape hit, NO_SHP if nothing was hit
+        Vct::Mod t;//Fraction of the ray (or the speed) travelled until the hit, in [0,1]
+        Vct normal;//Unitary normal of the contact, pointing from the shape hit to the ray or shape cast
+    };
+
+    /*Scene, a set of shapes (not owned) and a bounding volume hierarchy over them
+      Shapes are added and then the hierarchy is built, after the shapes move refit() updates it.
+      Queries are const and can be run from several threads at the same time*/
+    class Scn
+    {
+        /* Types and constants */
+
+        public:
+
+            //Number of rays traversed together by a ray cast
+            static constexpr std::size_t PACKET=8;
+
+        /* Attributes */
+
+        private:
+
+            std::vector<const Shp*> shapes;//Shapes of the scene
+
+            std::vector<Box> boxes;//Box of each shape when the hierarchy was built or refit
+
+            Bvh bvh;//Hierarchy over the boxes
+
+        /* Shapes */
+
+        public:
+
+            //Add a shape (the scene keeps a reference, the shape must outlive it), returns its handle
+            Scn_hdl add (const Shp &s)
+            {
+                shapes.push_back(&s);
+                return static_cast<Scn_hdl>(shapes.size()-1);
+            }
+
+            //Get a shape
+            const Shp& get (Scn_hdl h) const
+            {
+                return *shapes[h];
+            }
+
+            //Number of shapes
+            std::size_t size() const
+            {
+                return shapes.size();
+            }
+
+            //Remove every shape
+            void clear()
+            {
+                shapes.clear();
+                boxes.clear();
+                bvh.clear();
+            }
+
+            //Get the hierarchy
+            const Bvh& get_bvh() const
+            {
+                return bvh;
+            }
+
+        /* Hierarchy */
+
+        public:
+
+            //Build the hierarchy over the shapes
+            void build();
+
+            //Update the hierarchy after the shapes moved or changed their size
+            void refit();
+
+        /* Ray casts */
+
+        public:
+
+            //Cast n rays, the closest hit of each ray is written in hits (traversed in packets of PACKET rays)
+            void raycast (const Ray *rays, std::size_t n, Ray_hit *hits) const;
+
+            //Cast a single ray
+            Ray_hit raycast (const Ray &ray) const
+            {
+                Ray_hit h;
+                raycast(&ray,1,&h);
+                return h;
+            }
+
+        private:
+
+            //Cast a packet of at most PACKET rays
+            void raycast_packet (const Ray *rays, std::size_t n, Ray_hit *hits) const;
+
+        /* Shape casts */
+
+        public:
+
+            /*Sweep a shape at the given speed for a tick, returns the first shape of the scene hit (time in [0,1))
+              The shape cast can be part of the scene, ignore is skipped*/
+            Ray_hit shapecast (const Shp &s, const Vct &speed, Scn_hdl ignore=NO_SHP) const;
+
+        /* Overlap queries */
+
+        /*Results are given to a callback or written in a buffer given by the caller, nothing is allocated*/
+
+        public:
+
+            /*Call f(handle) for every shape in contact with the given shape
+              If f returns false the query stops, the function returns false in that case*/
+            template <class F>
+            bool overlap (const Shp &s, F f) const
+            {
+                Box b(s);
+                return bvh.overlap(b,[this,&s,&b,&f](std::uint32_t h)
+                {
+                    //Filter by the box of the shape before the exact contact
+                    if (!boxes[h].overlap(b)||!s.contact(*shapes[h]))
+                        return true;
+                    return static_cast<bool>(f(static_cast<Scn_hdl>(h)));
+                });
+            }
+
+            //Call f(handle) for every shape in contact with the given box
+            template <class F>
+            bool overlap (const Box &b, F f) const
+            {
+                return overlap(Rct(b.get_min(),b.get_diagonal()),f);
+            }
+
+            //Write the handles of the shapes in contact with the given shape, stops when cap handles are written
+            std::size_t overlap (const Shp &s, Scn_hdl *out, std::size_t cap) const;
+
+            //Write the handles of the shapes in contact with the given box, stops when cap handles are written
+            std::size_t overlap (const Box &b, Scn_hdl *out, std::size_t cap) const
+            {
+                return overlap(Rct(b.get_min(),b.get_diagonal()),out,cap);
+            }
+
+        /* Nearest shapes */
+
+        /*Distances are squared distances from the point to the surface of the shapes (0 if the point is inside)*/
+
+        public:
+
+            /*Write the k shapes closest to a point in out, closest first (and their squared distances in sq_dists if not null)
+              Only the shapes with a squared distance not greater than max_sq are considered, returns the number written*/
+            std::size_t knn (const Vct &p, std::size_t k, Scn_hdl *out, Vct::Mod *sq_dists=nullptr,
+                             Vct::Mod max_sq=std::numeric_limits<Vct::Mod>::infinity()) const;
+
+            //Get the shape closest to a point within the given radius, NO_SHP if there's none (its squared distance in sq_dist if not null)
+            Scn_hdl nearest (const Vct &p, Vct::Mod radius, Vct::Mod *sq_dist=nullptr) const
+            {
+                Scn_hdl h=NO_SHP;
+                knn(p,1,&h,sq_dist,radius*radius);
+                return h;
+            }
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_SCN_H_
@@ -0,0 +1,405 @@
+/*
+ * FDX_Shd.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Shd
+    Shards of the world simulated by processes, with halos exchanged through shared memory
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_SHD_H_
+#define _FDX_SHD_H_
+
+
+/* Includes */
+
+//Bodies
+#include "FDX_Bdy.hpp"
+
+//Broadphase
+#include "FDX_Bvh.hpp"
+
+//Fixed size integers
+#include <cstdint>
+
+//Ticks published to the other processes
+#include <atomic>
+
+//Name of the segments
+#include <string>
+
+//Segments, ids and boxes
+#include <vector>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Structs */
+
+    /*Record of a body written in shared memory, only plain data (it's read by other processes)
+      The columns are the ones of the body store*/
+    struct Shd_rec
+    {
+        std::uint64_t gid;//Global id of the body
+
+        Vct::Coord x, y;//Center
+
+        Vct::Coord hx, hy;//Extent
+
+        Vct::Coord ax, ay;//Axis
+
+        Vct::Coord vx, vy;//Speed
+
+        std::uint32_t dest;//Shard that takes the body (migration), Shd::NO_SHARD for halo copies
+
+        Shp::Tag tag;//Type of shape
+    };
+
+    /* Classes */
+
+    /*Partition of the world in a grid of regions, a shard per region
+      The cells of the border extend to infinity, so every point belongs to a shard.
+      The halo is the distance from the border of a region in which bodies are copied to the neighbours,
+      it can't be greater than the size of a cell (only the 8 neighbours of a cell receive copies)*/
+    class Shd_map
+    {
+        /* Attributes */
+
+        private:
+
+            Box world;//Box divided in cells
+
+            std::uint32_t nx, ny;//Number of cells in each axis
+
+            Vct::Mod halo;//Width of the halo
+
+        /* Constructors, copy control */
+
+        public:
+
+            //Complete constructor (at least one cell in each axis)
+            Shd_map (const Box &nworld, std::uint32_t nnx, std::uint32_t nny, Vct::Mod nhalo)
+            :world(nworld), nx(nnx?nnx:1), ny(nny?nny:1), halo(nhalo)
+            {}
+
+        /* Access methods */
+
+        public:
+
+            //Number of shards
+            std::uint32_t count() const
+            {
+                return nx*ny;
+            }
+
+            //Get the width of the halo
+            Vct::Mod get_halo() const
+            {
+                return halo;
+            }
+
+        /* Regions */
+
+        public:
+
+            //Shard whose region has the point
+            std::uint32_t shard (const Vct &p) const;
+
+            //Region of a shard
+            Box region (std::uint32_t id) const;
+
+            //Check if two different shards are neighbours (their cells touch)
+            bool neighbours (std::uint32_t a, std::uint32_t b) const;
+
+            //Neighbour of the shard a on the way to the shard b (a cell closer in each axis), a if they are the same
+            std::uint32_t toward (std::uint32_t a, std::uint32_t b) const;
+    };
+
+    /*Shard of the world, owned by a single process
+      Each shard simulates the bodies whose center is in its region and publishes in a segment of shared memory
+      the bodies near its border (halos) and the ones that left its region (migrations).
+      In every tick all the shards exchange their records in lockstep with their neighbours:
+      a shard copies the halos of its neighbours, so queries near the border see the bodies of the other side,
+      and takes the bodies that migrated to its region.
+      Queries over the shard give the same results as a single world as long as the halo is wider than
+      the size of the bodies plus their movement in a tick, and bodies move less than a cell in a tick.
+      A body that skips a neighbour in a tick is forwarded a cell per tick through the neighbours on the way,
+      until then it's owned by a shard whose region doesn't have it (get_forwarded counts them).
+      A shard waits for its neighbours up to a timeout, a neighbour that never starts or dies makes the exchange fail.
+      Segments are double buffered by the parity of the tick, so a shard can write the next tick
+      while its neighbours still read the last one*/
+    class Shd
+    {
+        /* Types and constants */
+
+        public:
+
+            //Destination of the halo copies
+            static constexpr std::uint32_t NO_SHARD=~std::uint32_t(0);
+
+        private:
+
+            //Header of a segment, followed by the records of the two buffers
+            struct alignas(64) Seg
+            {
+                std::atomic<std::uint64_t> tick;//Last tick written (0 before the first exchange)
+
+                std::atomic<std::uint32_t> ready;//Not zero once the header is initialized
+
+                std::uint32_t capacity;//Records of each buffer
+
+                std::uint32_t count[2];//Records written in each buffer
+
+                std::uint64_t run;//Run of the shard that created the segment
+
+                //Records of a buffer
+                Shd_rec* records (std::uint64_t t)
+                {
+                    return reinterpret_cast<Shd_rec*>(this+1)+(t%2)*capacity;
+                }
+            };
+
+        /* Attributes */
+
+        private:
+
+            Shd_map map;//Partition of the world
+
+            std::uint32_t id;//Shard of this process
+
+            std::string prefix;//Prefix of the names of the segments
+
+            std::uint64_t run;//Run of the shards
+
+            std::uint32_t capacity;//Records of each buffer
+
+            std::vector<std::uint32_t> near;//Neighbours
+
+            std::vector<Seg*> segs;//Segment of each neighbour (null until it's opened)
+
+            Seg *seg;//Own segment (null if it couldn't be created)
+
+            std::uint64_t tick;//Exchanges done
+
+            Vct::Mod timeout;//Seconds to wait for a neighbour
+
+            bool written;//The records of the tick are written, the neighbours were not read yet
+
+            bool fit;//The records of the tick written fit in the buffer
+
+            std::uint32_t forwarded;//Bodies of the last tick sent to a neighbour whose region doesn't have them
+
+            Bdy_store own;//Bodies owned
+
+            std::vector<std::uint64_t> gids;//Global id of each owned body (slot)
+
+            Bdy_store halo;//Copies of the bodies of the neighbours
+
+            std::vector<std::uint64_t> halo_gids;//Global id of each copy (dense index)
+
+            std::vector<Box> boxes;//Box of the owned bodies followed by the copies
+
+            Bvh bvh;//Hierarchy over the boxes
+
+        /* Constructors, copy control */
+
+        public:
+
+            /*Create the segment of a shard, named by the prefix and the id of the shard
+              Each buffer has room for the given number of records. The run must be the same for every shard of a run
+              and different between runs (for example the time of the launch): segments left by the shards of other runs
+              are not read, the neighbours wait until they are replaced*/
+            Shd (const Shd_map &nmap, std::uint32_t nid, const std::string &nprefix, std::uint64_t nrun, std::uint32_t ncapacity);
+
+            //Shards can't be copied
+            Shd (const Shd &) = delete;
+            Shd& operator= (const Shd &) = delete;
+
+            //Destructor, unmaps the segments and removes the own one
+            ~Shd();
+
+        /* Access methods */
+
+        public:
+
+            //Check if the segment was created
+            bool valid() const
+            {
+                return seg!=nullptr;
+            }
+
+            //Get the id of the shard
+            std::uint32_t get_id() const
+            {
+                return id;
+            }
+
+            //Get the number of exchanges done (or started, if the last one timed out waiting for the records of the neighbours)
+            std::uint64_t get_tick() const
+            {
+                return tick;
+            }
+
+            //Get the seconds to wait for a neighbour (10 by default)
+            Vct::Mod get_timeout() const
+            {
+                return timeout;
+            }
+
+            //Set the seconds to wait for a neighbour
+            void set_timeout (Vct::Mod ntimeout)
+            {
+                timeout=ntimeout;
+            }
+
+            //Get the number of bodies of the last exchange that skipped a neighbour and were forwarded through another one
+            std::uint32_t get_forwarded() const
+            {
+                return forwarded;
+            }
+
+            //Get the bodies owned (to integrate and solve them, bodies must be added and removed with the shard)
+            Bdy_store& bodies()
+            {
+                return own;
+            }
+
+            //Get the bodies owned
+            const Bdy_store& bodies() const
+            {
+                return own;
+            }
+
+            //Get the copies of the bodies of the neighbours
+            const Bdy_store& halos() const
+            {
+                return halo;
+            }
+
+            //Get the global id of an owned body
+            std::uint64_t get_gid (Bdy_hdl h) const
+            {
+                return gids[h.index];
+            }
+
+            //Get the global id of a copy (dense index)
+            std::uint64_t get_halo_gid (std::size_t i) const
+            {
+                return halo_gids[i];
+            }
+
+        /* Bodies */
+
+        public:
+
+            //Add a body owned by the shard with a global id (unique between every shard)
+            Bdy_hdl add (std::uint64_t gid, const Shp &s, const Vct &speed=Vct());
+
+            //Remove a body owned by the shard, returns false if the handle was not valid
+            bool remove (Bdy_hdl h)
+            {
+                return own.remove(h);
+            }
+
+        /* Exchange */
+
+        public:
+
+            /*Exchange the records of a tick with the neighbours, waits for them
+              Bodies that left the region migrate, the copies of the neighbours are replaced and the hierarchy is built.
+              Returns false if the segment is not valid, a neighbour can't be opened, a neighbour doesn't answer
+              within the timeout or the records don't fit (migrations that don't fit stay in the shard until the next tick,
+              halos that don't fit are lost for a tick).
+              After a timeout the next call waits again for the same tick, the bodies can't change in between*/
+            bool exchange();
+
+            //Update the boxes of the hierarchy after moving the owned bodies (the copies don't change between exchanges)
+            void refit();
+
+        private:
+
+            //Name of the segment of a shard
+            std::string name (std::uint32_t s) const;
+
+            //Size of a segment
+            std::size_t bytes() const;
+
+            //Map the segment of a neighbour, waits until it's created or the timeout
+            Seg* open (std::uint32_t s) const;
+
+            //Wait until every neighbour wrote the tick t, returns false after the timeout
+            bool wait (std::uint64_t t) const;
+
+            //Write the records of the tick
+            bool write();
+
+            //Read the records of the neighbours for the tick
+            void read();
+
+        /* Queries */
+
+        public:
+
+            /*Call f(gid,shape) for every body, owned or copied, in contact with the given shape
+              The shape is only valid during the call. If f returns false the query stops, the function returns false in that case*/
+            template <class F>
+            bool overlap (const Shp &s, F f) const
+            {
+                Box b(s);
+                Shp_buf buf;
+                std::size_t n=own.size();
+                return bvh.overlap(b,[this,n,&s,&b,&buf,&f](std::uint32_t i)
+                {
+                    //Filter by the box of the body before the exact contact
+                    if (!boxes[i].overlap(b))
+                        return true;
+                    const Shp &o=i<n?own.shape(i,buf):halo.shape(i-n,buf);
+                    if (!o.contact(s))
+                        return true;
+                    return static_cast<bool>(f(i<n?gids[own.handle(i).index]:halo_gids[i-n],o));
+                });
+            }
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_SHD_H_
@@ -0,0 +1,280 @@
+/*
+ * FDX_Sol.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Sol
+    Batched response of the contacts with impulses
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_SOL_H_
+#define _FDX_SOL_H_
+
+
+/* Includes */
+
+//Arrays of vectors
+#include "FDX_Vca.hpp"
+
+//Bodies
+#include "FDX_Bdy.hpp"
+
+//Fixed size integers
+#include <cstdint>
+
+//Columns
+#include <vector>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    /*Solver of contacts, changes the speeds of the bodies in contact with impulses along the normal (restitution)
+      and along the tangent (friction). The contacts of a step are kept in columns and solved together.
+      Bodies only translate, so the mass of a contact is the same for both directions.
+      Contacts are speculative: bodies that will touch during the step can only approach until they touch,
+      the restitution only applies to the bodies that are already touching.
+      Bodies that already overlap are pushed apart, removing a fraction of the overlap in each step*/
+    class Sol
+    {
+        /* Types and constants */
+
+        public:
+
+            //Type of the coordinates
+            typedef Vct::Coord Coord;
+            //Type of the modules, impulses and times
+            typedef Vct::Mod Mod;
+
+            //Iteration over the contacts
+            enum class Iteration
+            {
+                sequential,//Sequential impulses (Gauss-Seidel), each contact sees the impulses of the contacts before it
+                jacobi//Every contact is solved with the speeds of the last iteration, then the impulses are applied together
+            };
+
+        /* Attributes */
+
+        /*Parameters*/
+
+        private:
+
+            Mod restitution;//Coefficient of restitution, in [0,1]
+
+            Mod friction;//Coefficient of friction (Coulomb), not negative
+
+            Mod rest_speed;//Approaching speeds under this one don't bounce (resting contacts)
+
+            Mod push;//Fraction of the overlap removed in each step, in [0,1]
+
+            unsigned iterations;//Number of iterations
+
+            Iteration iteration;//Iteration over the contacts
+
+        /*Columns of the contacts*/
+
+        private:
+
+            std::vector<std::uint32_t> ca, cb;//Dense indices of the bodies, the first one is pushed along the normal
+
+            std::vector<Coord> nx, ny;//Unitary normal, from the second body to the first
+
+            std::vector<Mod> t0;//Fraction of the step before the bodies touch (0 if they are touching)
+
+            std::vector<Mod> depth;//Overlap of the bodies along the normal (0 if they are not overlapping)
+
+            std::vector<Mod> mass;//Mass of the contact, 1/(inverse mass of the first + inverse mass of the second)
+
+            std::vector<Mod> target;//Normal speed wanted after the step (restitution or speculative approach)
+
+            std::vector<Mod> jn, jt;//Accumulated impulses along the normal and the tangent
+
+            std::vector<Mod> djn, djt;//Impulses of the current iteration (Jacobi)
+
+            std::vector<Mod> weight;//Fraction of the impulse applied by each contact (Jacobi)
+
+            std::vector<std::uint32_t> count;//Contacts of each body (Jacobi)
+
+        /* Constructors */
+
+        public:
+
+            //Constructor with the coefficients and the iterations
+            explicit Sol (Mod nrestitution=0, Mod nfriction=0, unsigned niterations=8, Iteration niteration=Iteration::sequential)
+            :restitution(nrestitution), friction(nfriction), rest_speed(0), push(0.2), iterations(niterations), iteration(niteration)
+            {}
+
+        /* Access methods */
+
+        public:
+
+            //Get the coefficient of restitution
+            Mod get_restitution() const
+            {
+                return restitution;
+            }
+
+            //Set the coefficient of restitution
+            void set_restitution (Mod nrestitution)
+            {
+                restitution=nrestitution;
+            }
+
+            //Get the coefficient of friction
+            Mod get_friction() const
+            {
+                return friction;
+            }
+
+            //Set the coefficient of friction
+            void set_friction (Mod nfriction)
+            {
+                friction=nfriction;
+            }
+
+            //Get the speed under which contacts don't bounce
+            Mod get_rest_speed() const
+            {
+                return rest_speed;
+            }
+
+            //Set the speed under which contacts don't bounce
+            void set_rest_speed (Mod nrest_speed)
+            {
+                rest_speed=nrest_speed;
+            }
+
+            //Get the fraction of the overlap removed in each step
+            Mod get_push() const
+            {
+                return push;
+            }
+
+            //Set the fraction of the overlap removed in each step
+            void set_push (Mod npush)
+            {
+                push=npush;
+            }
+
+            //Get the number of iterations
+            unsigned get_iterations() const
+            {
+                return iterations;
+            }
+
+            //Set the number of iterations
+            void set_iterations (unsigned niterations)
+            {
+                iterations=niterations;
+            }
+
+            //Get the iteration over the contacts
+            Iteration get_iteration() const
+            {
+                return iteration;
+            }
+
+            //Set the iteration over the contacts
+            void set_iteration (Iteration niteration)
+            {
+                iteration=niteration;
+            }
+
+        /* Contacts */
+
+        public:
+
+            /*Add a contact between two bodies given by their dense indices
+              The normal is unitary and goes from the second body to the first, t is the fraction of the step before they touch
+              and the depth is their overlap along the normal (only if t is 0)*/
+            void add (std::uint32_t a, std::uint32_t b, const Vct &normal, Mod t=0, Mod ndepth=0);
+
+            /*Add the contacts of n pairs of bodies of a store given by their dense indices
+              A pair is in contact if the bodies, moving at their speeds, touch during dt. Returns the number of contacts added.
+              The overlap of circles and points is exact, the one of other shapes is taken from their boxes*/
+            std::size_t add (const Bdy_store &s, const std::uint32_t *a, const std::uint32_t *b, std::size_t n, Mod dt);
+
+            //Number of contacts
+            std::size_t size() const
+            {
+                return ca.size();
+            }
+
+            //Remove every contact
+            void clear();
+
+            //Accumulated impulse along the normal of each contact after the last solve
+            const Mod* normal_impulses() const {return jn.data();}
+
+            //Accumulated impulse along the tangent of each contact after the last solve
+            const Mod* tangent_impulses() const {return jt.data();}
+
+        /* Solver */
+
+        public:
+
+            /*Change the speeds of the bodies (indexed by the dense index) with the impulses of the contacts, for a step of dt
+              The inverse masses are indexed by the dense index too, 0 for bodies that can't be moved*/
+            void solve (Vca &spd, const Mod *inv_mass, Mod dt);
+
+            //Change the speeds of the bodies of a store
+            void solve (Bdy_store &s, const Mod *inv_mass, Mod dt)
+            {
+                solve(s.speeds(),inv_mass,dt);
+            }
+
+        private:
+
+            //Compute the mass and the target speed of every contact, the impulses start at 0
+            void prepare (const Vca &spd, const Mod *inv_mass, Mod dt);
+
+            //Iteration with sequential impulses
+            void iterate_sequential (Vca &spd, const Mod *inv_mass);
+
+            //Iteration of Jacobi
+            void iterate_jacobi (Vca &spd, const Mod *inv_mass);
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_SOL_H_
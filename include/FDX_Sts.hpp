@@ -0,0 +1,227 @@
+/*
+ * FDX_Sts.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Sts
+    Hot path statistics (counters compiled only with FDX_ARROW_STATS)
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_STS_H_
+#define _FDX_STS_H_
+
+
+/* Includes */
+
+//Fixed size integers
+#include <cstdint>
+
+//Atomic counters (relaxed, only written by the owner thread)
+#include <atomic>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+/*Instrumentation of the hot paths
+  Defining FDX_ARROW_STATS (CMake option of the same name) compiles the counters,
+  otherwise every macro expands to nothing and the library pays no cost at all*/
+#ifdef FDX_ARROW_STATS
+
+//Count a call to an operation between a pair of shapes
+#define FDX_STS_CALL(op,pair) ::fdx::arrow::sts::count_call(::fdx::arrow::sts::Op::op,::fdx::arrow::sts::Pair::pair)
+
+//Count an event (early-outs, clamps...)
+#define FDX_STS_EVENT(evt) ::fdx::arrow::sts::count_event(::fdx::arrow::sts::Evt::evt)
+
+//Count the number of region iterations taken by a loop
+#define FDX_STS_LOOP(n) ::fdx::arrow::sts::count_loop(n)
+
+#else
+
+#define FDX_STS_CALL(op,pair) ((void)0)
+#define FDX_STS_EVENT(evt) ((void)0)
+#define FDX_STS_LOOP(n) ((void)(n))
+
+#endif
+
+namespace fdx { namespace arrow { namespace sts
+{
+    /*
+        Data types
+     */
+
+    /* Enums */
+
+    //Operations that are counted
+    enum class Op : int
+    {
+        contact,
+        tth,
+        mov_against,
+        size//Number of operations
+    };
+
+    //Pairs of shapes (as implemented by the calculus, Crl and Pnt share their functions)
+    enum class Pair : int
+    {
+        crlpnt_crlpnt,
+        crlpnt_rct,
+        rct_rct,
+        obb_obb,//Oriented rectangles, and rectangles against them
+        crlpnt_pol,
+        pol_pol,//Convex polygons, and rectangles against them
+        cap_shp,//Capsules against any shape
+        size//Number of pairs
+    };
+
+    //Events on the hot paths
+    enum class Evt : int
+    {
+        disc_neg,//The 2nd degree equation of a TTH has no solution
+        in_contact,//TTH is zero because the shapes were already in contact
+        no_speed,//TTH is negative because there is no speed
+        clamp,//A movement against a shape restricted the speed
+        hint,//A TTH was taken from the region of a hint, without the walk through the regions
+        size//Number of events
+    };
+
+    /* Constants */
+
+    //Bins of the loop iterations histogram, the last bin holds that number of iterations or more
+    constexpr int HIST_SIZE=8;
+
+    /* Classes */
+
+    //Aggregated value of the counters
+    struct Stats
+    {
+        std::uint64_t calls[static_cast<int>(Op::size)][static_cast<int>(Pair::size)];//Calls per operation and pair
+        std::uint64_t events[static_cast<int>(Evt::size)];//Events
+        std::uint64_t loop_hist[HIST_SIZE];//Histogram of the region iterations, bin i holds the loops that took i iterations
+
+        //Number of calls of an operation between a pair
+        std::uint64_t get_calls(Op o, Pair p) const
+        {
+            return calls[static_cast<int>(o)][static_cast<int>(p)];
+        }
+
+        //Number of times an event happened
+        std::uint64_t get_events(Evt e) const
+        {
+            return events[static_cast<int>(e)];
+        }
+
+        //Add the counters of another stats
+        void operator+= (const Stats &s);
+    };
+
+    //Counters owned by a thread (only the owner writes them, any thread can read them)
+    struct Local
+    {
+        std::atomic<std::uint64_t> calls[static_cast<int>(Op::size)][static_cast<int>(Pair::size)];
+        std::atomic<std::uint64_t> events[static_cast<int>(Evt::size)];
+        std::atomic<std::uint64_t> loop_hist[HIST_SIZE];
+
+        //Registers the counters so they can be aggregated
+        Local();
+
+        //Moves the counters to the retired totals
+        ~Local();
+
+        Local (const Local &) = delete;
+        Local& operator= (const Local &) = delete;
+
+        //Read the counters
+        Stats read() const;
+
+        //Set the counters to zero
+        void clear();
+    };
+
+    /*
+        Function prototypes
+    */
+
+    /* Stats API */
+
+    //Check if the counters were compiled
+    constexpr bool enabled()
+    {
+#ifdef FDX_ARROW_STATS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    //Aggregate the counters of all the threads (live and finished)
+    Stats snapshot();
+
+    //Set all the counters to zero (increments done at the same time by other threads may survive)
+    void reset();
+
+    /* Counting (used by the macros) */
+
+    //Counters of the calling thread
+    Local& local();
+
+    //Increment a counter, there is a single writer so there is no need for a locked add
+    inline void bump(std::atomic<std::uint64_t> &c)
+    {
+        c.store(c.load(std::memory_order_relaxed)+1,std::memory_order_relaxed);
+    }
+
+    //Count a call
+    inline void count_call(Op o, Pair p)
+    {
+        bump(local().calls[static_cast<int>(o)][static_cast<int>(p)]);
+    }
+
+    //Count an event
+    inline void count_event(Evt e)
+    {
+        bump(local().events[static_cast<int>(e)]);
+    }
+
+    //Count a loop that took n iterations
+    inline void count_loop(int n)
+    {
+        bump(local().loop_hist[n<HIST_SIZE-1?n:HIST_SIZE-1]);
+    }
+
+}}}//End of namespace
+
+//End of library
+#endif // _FDX_STS_H_
@@ -0,0 +1,157 @@
+/*
+ * FDX_Trc.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Trc
+    Scoped tracing of the simulation phases (Chrome trace export)
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_TRC_H_
+#define _FDX_TRC_H_
+
+
+/* Includes */
+
+//Fixed size integers
+#include <cstdint>
+
+//Enable flag and ring buffers
+#include <atomic>
+
+//Output streams
+#include <iostream>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+//Helpers to build an unique name for the span variables
+#define FDX_TRC_CAT_(a,b) a##b
+#define FDX_TRC_CAT(a,b) FDX_TRC_CAT_(a,b)
+
+//Trace the rest of the current scope as a span with the given name (must be a string literal or outlive the dump)
+#define FDX_TRC_SPAN(name) ::fdx::arrow::trc::Span FDX_TRC_CAT(fdx_trc_span_,__LINE__)(name)
+
+namespace fdx { namespace arrow { namespace trc
+{
+    /*
+        Constants
+     */
+
+    //Number of spans kept by each thread (older spans are overwritten), power of two
+    constexpr std::uint64_t RING_SIZE=1<<14;
+
+    /*
+        Function prototypes
+    */
+
+    /* Control */
+
+    //Flag checked by every span (relaxed, the cost of a disabled span is this load and a branch)
+    extern std::atomic<bool> on_flag;
+
+    //Check if the tracing is enabled
+    inline bool enabled()
+    {
+        return on_flag.load(std::memory_order_relaxed);
+    }
+
+    //Enable or disable the tracing
+    void enable(bool e);
+
+    //Discard every span recorded so far, freeing the rings of the threads that exited (they are kept until then for the dump)
+    void clear();
+
+    /* Recording (used by the spans) */
+
+    //Current time in nanoseconds since the start of the tracer
+    std::uint64_t now();
+
+    //Store a finished span in the ring buffer of the calling thread
+    void record(const char *name, std::uint64_t begin, std::uint64_t end);
+
+    /* Export */
+
+    //Write every span in the ring buffers as Chrome trace JSON (chrome://tracing, Perfetto)
+    void dump(std::ostream &os);
+
+    //Write the Chrome trace JSON to a file, returns false if the file can't be written
+    bool dump(const char *path);
+
+    /*
+        Classes
+    */
+
+    //Scoped span, records its begin and end timestamps if the tracing was enabled at its construction
+    class Span
+    {
+        /* Attributes */
+
+        private:
+
+            const char *name;//Name of the span, null if the tracing is disabled
+
+            std::uint64_t begin;//Begin timestamp
+
+        /* Constructors, copy control */
+
+        public:
+
+            //Open the span
+            explicit Span (const char *nname)
+            :name(nullptr), begin(0)
+            {
+                if (enabled())
+                {
+                    name=nname;
+                    begin=now();
+                }
+            }
+
+            //Close the span
+            ~Span()
+            {
+                if (name)
+                    record(name,begin,now());
+            }
+
+            Span (const Span &) = delete;
+            Span& operator= (const Span &) = delete;
+    };
+
+}}}//End of namespace
+
+//End of library
+#endif // _FDX_TRC_H_
@@ -0,0 +1,293 @@
+/*
+ * FDX_Vca.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Vca
+    Arrays of 2D vectors in columns (SoA) with bulk operations
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_VCA_H_
+#define _FDX_VCA_H_
+
+
+/* Includes */
+
+//Vectors
+#include "FDX_Vct.hpp"
+
+//Columns
+#include <vector>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Class definitions
+    */
+    class Vca;
+
+    /*
+        Function prototypes
+    */
+
+    /* Vca friends */
+
+    //Add operator: adds the vectors with the same index (same size)
+    Vca operator+ (const Vca &a, const Vca &b);
+
+    //Subtract operator: subtracts the vectors with the same index (same size, first - second)
+    Vca operator- (const Vca &a, const Vca &b);
+
+    //Product operator: multiply every vector by a coefficient
+    Vca operator* (const Vca &a, Vct::Mod coefficient);
+
+    //Product operator: multiply every vector by a coefficient
+    Vca operator* (Vct::Mod coefficient, const Vca &a);
+
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    /*Array of 2D vectors (VctArray)
+      The X and Y coordinates are kept in their own contiguous columns, without the vtable of Vct,
+      so the bulk operations are plain loops that the compiler vectorizes.
+      The results are the same as calling the operation of Vct on every vector*/
+    class Vca
+    {
+        /* Types and constants */
+
+        public:
+
+            //Type of the coordinates X and Y
+            typedef Vct::Coord Coord;
+            //Type of the module of a vector, angles and coefficients
+            typedef Vct::Mod Mod;
+
+        /* Attributes */
+
+        /*Columns (same size)*/
+
+        public:
+
+            std::vector<Coord> x, y;//Coordinates X and Y
+
+        /* Copy control, constructors */
+
+        public:
+
+            //Default constructor (empty)
+            Vca() = default;
+
+            //Size constructor, every vector is a copy of the given one
+            explicit Vca (std::size_t n, const Vct &v=Vct())
+            : x(n,v.x), y(n,v.y)
+            {}
+
+            //Conversion from an array of vectors
+            Vca (const Vct *v, std::size_t n)
+            {
+                assign(v,n);
+            }
+
+            //Conversion from a vector of vectors
+            explicit Vca (const std::vector<Vct> &v)
+            : Vca(v.data(),v.size())
+            {}
+
+        /* Operators and conversors */
+
+        public:
+
+            //Add operator: adds the vectors with the same index (same size)
+            friend Vca operator+ (const Vca &a, const Vca &b);
+
+            //Subtract operator: subtracts the vectors with the same index (same size, first - second)
+            friend Vca operator- (const Vca &a, const Vca &b);
+
+            //Product operator: multiply every vector by a coefficient
+            friend Vca operator* (const Vca &a, Mod coefficient);
+
+            //Product operator: multiply every vector by a coefficient
+            friend Vca operator* (Mod coefficient, const Vca &a);
+
+            //Negate method: changes the coordinates of every vector to their contrary sign value
+            void inv_dir();
+
+            //Add to operator: adds the vectors with the same index (same size)
+            void operator+= (const Vca &v);
+
+            //Substract from operator: substracts the vectors with the same index (same size)
+            void operator-= (const Vca &v);
+
+            //Add to operator: adds one vector to every vector
+            void operator+= (const Vct &v);
+
+            //Substract from operator: substracts one vector from every vector
+            void operator-= (const Vct &v);
+
+            //Multiply by operator: multiplies every vector by a coefficient
+            void operator*= (Mod coefficient);
+
+            //Add the vectors with the same index multiplied by a coefficient (same size, positions += speeds*dt)
+            void add_scaled (const Vca &v, Mod coefficient);
+
+        /* Access methods */
+
+        public:
+
+            //Number of vectors
+            std::size_t size() const
+            {
+                return x.size();
+            }
+
+            //Check if there are no vectors
+            bool empty() const
+            {
+                return x.empty();
+            }
+
+            //Get a vector
+            Vct get (std::size_t i) const
+            {
+                return Vct(x[i],y[i]);
+            }
+
+            //Set a vector
+            void set (std::size_t i, const Vct &v)
+            {
+                x[i]=v.x;
+                y[i]=v.y;
+            }
+
+            //Add a vector at the end
+            void push_back (const Vct &v)
+            {
+                x.push_back(v.x);
+                y.push_back(v.y);
+            }
+
+            //Remove the last vector
+            void pop_back()
+            {
+                x.pop_back();
+                y.pop_back();
+            }
+
+            //Change the number of vectors, the new ones are copies of the given one
+            void resize (std::size_t n, const Vct &v=Vct())
+            {
+                x.resize(n,v.x);
+                y.resize(n,v.y);
+            }
+
+            //Reserve memory for n vectors
+            void reserve (std::size_t n)
+            {
+                x.reserve(n);
+                y.reserve(n);
+            }
+
+            //Remove every vector
+            void clear()
+            {
+                x.clear();
+                y.clear();
+            }
+
+        /* Conversion to and from Vct */
+
+        public:
+
+            //Replace the vectors with the ones of an array
+            void assign (const Vct *v, std::size_t n);
+
+            //Write the vectors to an array of size()
+            void copy_to (Vct *out) const;
+
+            //Get the vectors as a vector of Vct
+            std::vector<Vct> to_vct() const
+            {
+                std::vector<Vct> rv(size());
+                copy_to(rv.data());
+                return rv;
+            }
+
+        /* Module operations (results written to arrays of size())*/
+
+        public:
+
+            //Get the squared modules of the vectors
+            void sq_mod (Mod *out) const;
+
+            //Get the modules of the vectors
+            void mod (Mod *out) const;
+
+            //Change the module of every vector to the given value (direction inverted if the number is negative)
+            void limmod (Mod nm);
+
+            //Turn every vector into its unitary vector
+            void unitary();
+
+        /* Products (results written to arrays of size())*/
+
+        public:
+
+            //Dot product of the vectors with the same index (same size)
+            void dot (const Vca &v, Mod *out) const;
+
+            //Dot product of every vector with a given vector
+            void dot (const Vct &v, Mod *out) const;
+
+        /* Angle operations (results written to arrays of size())*/
+
+        public:
+
+            //Get the angles that the vectors form with +OX, within [0,2*PI)
+            void angle (Mod *out) const
+            {
+                Vct::angle(x.data(),y.data(),out,size());
+            }
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_VCA_H_
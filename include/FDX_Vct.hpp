@@ -48,6 +48,9 @@
 //Input/output streams
 #include <iostream>
 
+//Sizes of the batches
+#include <cstddef>
+
 /* Defines */
 
 /*Constants*/
@@ -75,29 +78,29 @@ namespace fdx { namespace arrow
 
     /*Checks if two doubles are almost identical (using EPSILON fast method)
       Not safe if the values are close to zero, use with caution*/
-    bool almost_equal (double a, double b);
+    constexpr bool almost_equal (double a, double b);
 
     /* Vct friends */
 
     /*Operators and conversors*/
 
     //Equality operator: same X and Y coordinates
-    bool operator== (const Vct &a, const Vct &b);
+    constexpr bool operator== (const Vct &a, const Vct &b);
 
     //Inequality operator: opposite of equality
-    bool operator!= (const Vct &a, const Vct &b);
+    constexpr bool operator!= (const Vct &a, const Vct &b);
 
     //Add operator: adds X and Y coordinates by separate to create a new vector
-    Vct operator+ (const Vct &a, const Vct &b);
+    constexpr Vct operator+ (const Vct &a, const Vct &b);
 
     //Subtract operator: subtracts the X and Y coordinates by separate to create a new vector (first - second)
-    Vct operator- (const Vct &a, const Vct &b);
+    constexpr Vct operator- (const Vct &a, const Vct &b);
 
     //Product operator: multiply the X and Y coordinates by a coefficient
-    Vct operator* (const Vct &a, double coefficient);
+    constexpr Vct operator* (const Vct &a, double coefficient);
 
     //Product operator: multiply the X and Y coordinates by a coefficient
-    Vct operator* (double coefficient, const Vct &a);
+    constexpr Vct operator* (double coefficient, const Vct &a);
 
     //Input operator
     std::istream &operator>> (std::istream &is, Vct &v);
@@ -162,30 +165,30 @@ namespace fdx { namespace arrow
         public:
 
             //Default constructor
-            Vct()
+            constexpr Vct()
             : x(DEFX), y(DEFY)
             {}
 
             //Coordinate constructor
-            Vct (Coord nx, Coord ny)
+            constexpr Vct (Coord nx, Coord ny)
             : x(nx), y(ny)
             {}
 
             //Copy constructor (same as default)
-            Vct (const Vct &v)
+            constexpr Vct (const Vct &v)
             : Vct (v.x,v.y)
             {}
 
             //Copy constructor with coefficient
-            Vct (const Vct &v, Mod coefficient)
+            constexpr Vct (const Vct &v, Mod coefficient)
             : x(v.x*coefficient), y(v.y*coefficient)
             {}
 
             //Destructor (virtual for derivated classes) (same as default)
-            virtual ~Vct() = default;
+            constexpr virtual ~Vct() {}
 
             //Copy assignment operator
-            Vct& operator= (const Vct &v)
+            constexpr Vct& operator= (const Vct &v)
             {
                 x=v.x;
                 y=v.y;
@@ -197,22 +200,22 @@ namespace fdx { namespace arrow
         public:
 
             //Equality operator: same X and Y coordinates
-            friend bool operator== (const Vct &a, const Vct &b);
+            friend constexpr bool operator== (const Vct &a, const Vct &b);
 
             //Inequality operator
-            friend bool operator!= (const Vct &a, const Vct &b);
+            friend constexpr bool operator!= (const Vct &a, const Vct &b);
 
             //Add operator: adds X and Y coordinates by separate to create a new vector
-            friend Vct operator+ (const Vct &a, const Vct &b);
+            friend constexpr Vct operator+ (const Vct &a, const Vct &b);
 
             //Subtract operator: subtracts the X and Y coordinates by separate to create a new vector (first - second)
-            friend Vct operator- (const Vct &a, const Vct &b);
+            friend constexpr Vct operator- (const Vct &a, const Vct &b);
 
             //Product operator: multiply the X and Y coordinates by a coefficient
-            friend Vct operator* (const Vct &a, Mod coefficient);
+            friend constexpr Vct operator* (const Vct &a, Mod coefficient);
 
             //Product operator: multiply the X and Y coordinates by a coefficient
-            friend Vct operator* (Mod coefficient, const Vct &a);
+            friend constexpr Vct operator* (Mod coefficient, const Vct &a);
 
             //Input operator
             friend std::istream &operator>> (std::istream &is, Vct &v);
@@ -221,40 +224,40 @@ namespace fdx { namespace arrow
             friend std::ostream &operator<< (std::ostream &os, Vct &v);
 
             //Bool converter: X and Y coordinates are not 0
-            operator bool() const
+            constexpr operator bool() const
             {
                 return x||y;
             }
 
             //Negate method: changes the coordinates of this vector to their contrary sign value
-            void inv_dir()
+            constexpr void inv_dir()
             {
                 x=-x;
                 y=-y;
             }
 
             //Negate operator: creates a new vector with the opposite coordinates of this vector
-            Vct operator-() const
+            constexpr Vct operator-() const
             {
                 return Vct (-x,-y);
             }
 
             //Add to operator: adds one vector to this vector
-            void operator+= (const Vct &v)
+            constexpr void operator+= (const Vct &v)
             {
                 x+=v.x;
                 y+=v.y;
             }
 
             //Substract from operator: substract one vector to this vector
-            void operator-= (const Vct &v)
+            constexpr void operator-= (const Vct &v)
             {
                 x-=v.x;
                 y-=v.y;
             }
 
             //Multiply by operator: muliplies this vector by a coefficient
-            void operator*= (Mod coefficient)
+            constexpr void operator*= (Mod coefficient)
             {
                 x*=coefficient;
                 y*=coefficient;
@@ -265,7 +268,7 @@ namespace fdx { namespace arrow
         public:
 
             //Set the X and Y coordinates
-            void setXY (Coord nx, Coord ny)
+            constexpr void setXY (Coord nx, Coord ny)
             {
                 x=nx;
                 y=ny;
@@ -275,7 +278,7 @@ namespace fdx { namespace arrow
         private:
 
             //Reverse the coordinates if needed
-            void rev_cord()
+            constexpr void rev_cord()
             {
                 if (DEF_REVER_X)
                     x=-x;
@@ -287,7 +290,7 @@ namespace fdx { namespace arrow
         public:
 
             //Get the squared module of this vector (efficient checking)
-            Mod sq_mod() const
+            constexpr Mod sq_mod() const
             {
                 return x*x+y*y;
             }
@@ -299,12 +302,45 @@ namespace fdx { namespace arrow
             }
 
             //Change the module of this vector to the given value (direction inverted if the number is negative)
-            void limmod (Mod nm);
+            void limmod (Mod nm)
+            {
+                //If this vector is not null, multiply it by a coefficient
+                if (operator bool())
+                {
+                    operator*=(nm/mod());
+                }
+                //If the operator is null...
+                else
+                {
+                    /*...if null is allowed, no operation is performed,
+                      else, we use the angle to turn it into an unary vector*/
+                    if (!DEF_NULL_ALLOWED)//null vector is not allowed
+                        set_ang_mod(DEF_NULL_UNI_ANGLE,nm);
+                }
+            }
 
             //Turn this vector into the unitary vector
-            void unitary();
+            void unitary()
+            {
+                //If this vector is not null, multiply it by the inverse of its module
+                if (operator bool())
+                {
+                    operator*=(1/mod());
+                }
+                //If the operator is null...
+                else
+                {
+                    /*...if null is allowed, no operation is performed,
+                      else, we use the angle to turn it into an unary vector*/
+                    if (!DEF_NULL_ALLOWED)//null vector is not allowed
+                        set_ang_mod(DEF_NULL_UNI_ANGLE);
+                }
+            }
 
-        /* Angle operations */
+        /* Angle operations
+           With FDX_ARROW_FAST_TRIG (CMake option of the same name) the sine, cosine and atan2 are approximated by polynomials.
+           Maximum absolute error of the coordinates: 1e-8 for angles within 1e8 radians, 1e-7 within 1e9 (greater angles are not valid)
+           Maximum error of the angles: 1e-8 radians */
 
         /*Define a vector with a given angle and module
           Static version for defining new vectors and non-static for modifying this vector*/
@@ -345,6 +381,22 @@ namespace fdx { namespace arrow
                 return angle()-nangle;
             }
 
+        /*Batches over arrays, same results as the versions for one vector (written to be vectorized)*/
+
+        public:
+
+            //Create vectors with the given angles and modules, into the arrays of coordinates
+            static void mk_ang_mod (const Mod *angle, const Mod *module, Coord *x, Coord *y, std::size_t n);
+
+            //Create vectors with the given angles and modules
+            static void mk_ang_mod (const Mod *angle, const Mod *module, Vct *out, std::size_t n);
+
+            //Get the angles that the vectors, given by their arrays of coordinates, form with +OX
+            static void angle (const Coord *x, const Coord *y, Mod *out, std::size_t n);
+
+            //Get the angles that the vectors form with +OX
+            static void angle (const Vct *v, Mod *out, std::size_t n);
+
         /* Rotation of vectors */
 
         public:
@@ -368,7 +420,7 @@ namespace fdx { namespace arrow
             }
 
             //Fast check to see if this and another vectors that are linearly dependant have the same direction
-            bool same_dir_fast (const Vct &v) const
+            constexpr bool same_dir_fast (const Vct &v) const
             {
                 //Check that the coordinates of this vector and the other have the same sign
                 //Try to check if they are different, and if they are not, they must be the same
@@ -448,6 +500,64 @@ namespace fdx { namespace arrow
             }
     };
 
+    /*
+        Functions
+    */
+
+    /* Comparison of coordinates and angles */
+
+    /*Checks if two doubles are almost identical (using EPSILON fast method)
+      Not safe if the values are close to zero, use with caution*/
+    constexpr bool almost_equal (double a, double b)
+    {
+        return
+            (
+                (a==b)//First, fast comparision
+                ||
+                ((a<b?b-a:a-b)<EPSILON_COMP)//Second comparision, not safe for all range of values
+            );
+    }
+
+    /* Vct friends */
+
+    /*Operators and conversors*/
+
+    //Equality operator: same X and Y coordinates
+    constexpr bool operator== (const Vct &a, const Vct &b)
+    {
+        return (almost_equal(a.x,b.x)&&almost_equal(a.y,b.y));
+    }
+
+    //Inequality operator: opposite of equality
+    constexpr bool operator!= (const Vct &a, const Vct &b)
+    {
+        return !(a==b);
+    }
+
+    //Add operator: adds X and Y coordinates by separate to create a new vector
+    constexpr Vct operator+ (const Vct &a, const Vct &b)
+    {
+        return Vct (a.x+b.x,a.y+b.y);
+    }
+
+    //Subtract operator: subtracts the X and Y coordinates by separate to create a new vector (first - second)
+    constexpr Vct operator- (const Vct &a, const Vct &b)
+    {
+        return Vct (a.x-b.x,a.y-b.y);
+    }
+
+    //Product operator: multiply the X and Y coordinates by a coefficient
+    constexpr Vct operator* (const Vct &a, Vct::Mod coefficient)
+    {
+        return Vct (a,coefficient);
+    }
+
+    //Product operator: multiply the X and Y coordinates by a coefficient
+    constexpr Vct operator* (Vct::Mod coefficient, const Vct &a)
+    {
+        return Vct (a,coefficient);
+    }
+
 }}//End of namespace
 
 //End of library
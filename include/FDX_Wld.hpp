@@ -0,0 +1,295 @@
+/*
+ * FDX_Wld.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Wld
+    World of bodies published as snapshots for readers without locks
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_WLD_H_
+#define _FDX_WLD_H_
+
+
+/* Includes */
+
+//Bodies
+#include "FDX_Bdy.hpp"
+
+//Broadphase
+#include "FDX_Bvh.hpp"
+
+//Fixed size integers
+#include <cstdint>
+
+//Epochs and the published snapshot
+#include <atomic>
+
+//Retired snapshots
+#include <vector>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    /*World of bodies with snapshot isolation
+      A single writer thread changes its own store of bodies and publishes a copy of it as an immutable snapshot.
+      Readers on any thread query the last snapshot published without locks, while the writer keeps working.
+      Snapshots are swapped atomically and reclaimed by epochs: a snapshot replaced in the epoch e is reused
+      once every reader active is in an epoch not older than e. Snapshots reclaimed are reused by the next publish*/
+    class Wld
+    {
+        /* Types and constants */
+
+        public:
+
+            /*Greatest number of views alive at the same time
+              A view that finds every slot taken waits, yielding, until another view ends*/
+            static constexpr std::size_t MAX_READERS=64;
+
+            //Snapshot of the world, never changed while it's published
+            class Snp
+            {
+                friend class Wld;
+
+                /* Attributes */
+
+                private:
+
+                    Bdy_store bodies;//Copy of the bodies
+
+                    std::vector<Box> boxes;//Box of each body (dense index)
+
+                    Bvh bvh;//Hierarchy over the boxes
+
+                    std::uint64_t version;//Number of publishes before this one
+
+                    std::uint64_t retired;//Epoch in which it was replaced
+
+                /* Access methods */
+
+                public:
+
+                    //Get the bodies
+                    const Bdy_store& get_bodies() const
+                    {
+                        return bodies;
+                    }
+
+                    //Get the hierarchy over the bodies
+                    const Bvh& get_bvh() const
+                    {
+                        return bvh;
+                    }
+
+                    //Get the box of a body (dense index)
+                    const Box& get_box (std::size_t i) const
+                    {
+                        return boxes[i];
+                    }
+
+                    //Get the version (0 for the first snapshot published)
+                    std::uint64_t get_version() const
+                    {
+                        return version;
+                    }
+
+                /* Queries */
+
+                public:
+
+                    /*Call f(handle) for every body in contact with the given shape
+                      If f returns false the query stops, the function returns false in that case*/
+                    template <class F>
+                    bool overlap (const Shp &s, F f) const
+                    {
+                        Box b(s);
+                        Shp_buf buf;
+                        return bvh.overlap(b,[this,&s,&b,&buf,&f](std::uint32_t i)
+                        {
+                            //Filter by the box of the body before the exact contact
+                            if (!boxes[i].overlap(b)||!bodies.shape(i,buf).contact(s))
+                                return true;
+                            return static_cast<bool>(f(bodies.handle(i)));
+                        });
+                    }
+            };
+
+            /*Access of a reader to the last snapshot, the snapshot is kept while the view lives
+              Views are cheap to create, they should be short lived so old snapshots can be reused
+              Each view takes its own slot, also views nested on the same thread*/
+            class View
+            {
+                friend class Wld;
+
+                /* Attributes */
+
+                private:
+
+                    const Wld *world;//World read
+
+                    std::size_t slot;//Slot of the reader
+
+                    const Snp *snp;//Snapshot read
+
+                /* Constructors, copy control */
+
+                private:
+
+                    //Pin the epoch of the world in a slot and read the snapshot
+                    explicit View (const Wld &w);
+
+                public:
+
+                    //Views can be moved, not copied
+                    View (const View &) = delete;
+                    View& operator= (const View &) = delete;
+                    View (View &&v)
+                    :world(v.world), slot(v.slot), snp(v.snp)
+                    {
+                        v.world=nullptr;
+                    }
+
+                    //Destructor, releases the slot
+                    ~View();
+
+                /* Access methods */
+
+                public:
+
+                    //Get the snapshot
+                    const Snp& operator*() const
+                    {
+                        return *snp;
+                    }
+
+                    //Get the snapshot
+                    const Snp* operator->() const
+                    {
+                        return snp;
+                    }
+            };
+
+        private:
+
+            //Slot of a reader, in its own cache line
+            struct alignas(64) Slot
+            {
+                std::atomic<std::uint64_t> epoch;//Epoch pinned by the reader, IDLE if the slot is free
+            };
+
+            //Epoch of a free slot
+            static constexpr std::uint64_t IDLE=0;
+
+        /* Attributes */
+
+        private:
+
+            Bdy_store work;//Bodies changed by the writer
+
+            std::atomic<const Snp*> current;//Snapshot published
+
+            mutable std::atomic<std::uint64_t> epoch;//Current epoch (starts at 1)
+
+            mutable Slot slots[MAX_READERS];//Slots of the readers
+
+            std::vector<Snp*> retired;//Snapshots replaced, waiting for their readers
+
+            std::vector<Snp*> spare;//Snapshots reclaimed, reused by the next publish
+
+            std::uint64_t published;//Number of publishes
+
+        /* Constructors, copy control */
+
+        public:
+
+            //Default constructor, publishes an empty snapshot
+            Wld();
+
+            //Worlds can't be copied
+            Wld (const Wld &) = delete;
+            Wld& operator= (const Wld &) = delete;
+
+            //Destructor (there must be no views left)
+            ~Wld();
+
+        /* Writer (single thread) */
+
+        public:
+
+            //Get the bodies changed by the writer (readers don't see the changes until they are published)
+            Bdy_store& edit()
+            {
+                return work;
+            }
+
+            //Publish a snapshot of the bodies of the writer and reclaim the snapshots that are not read anymore
+            void publish();
+
+            //Number of snapshots replaced that still have readers
+            std::size_t pending() const
+            {
+                return retired.size();
+            }
+
+        private:
+
+            //Move the snapshots that can't be read anymore to the spares
+            void reclaim();
+
+        /* Readers (any thread) */
+
+        public:
+
+            /*Read the last snapshot published
+              Every view alive takes a slot, nested reads on a thread take one each. With MAX_READERS views alive
+              this waits for one of them to end, so a thread must not nest more than MAX_READERS reads*/
+            View read() const
+            {
+                return View(*this);
+            }
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_WLD_H_
@@ -0,0 +1,146 @@
+/*
+ * FDX_Wrk.hpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (header file)
+    FDX_Wrk
+    Pool of worker threads
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/*Header guard*/
+#ifndef _FDX_WRK_H_
+#define _FDX_WRK_H_
+
+
+/* Includes */
+
+//Workers and their queue
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+#include <vector>
+#include <functional>
+
+//Results of the tasks
+#include <future>
+#include <memory>
+#include <type_traits>
+
+/* Defines */
+
+/*Constants*/
+
+/*Macros*/
+
+namespace fdx { namespace arrow
+{
+    /*
+        Data types
+     */
+
+    /* Classes */
+
+    /*Pool of worker threads that run the tasks of a queue in the order they were given
+      Tasks can be given from any thread. The pool waits for the tasks left before being destroyed*/
+    class Wrk
+    {
+        /* Types and constants */
+
+        public:
+
+            //Task of the queue
+            typedef std::function<void()> Task;
+
+        /* Attributes */
+
+        private:
+
+            std::vector<std::thread> workers;//Threads of the pool
+
+            std::deque<Task> tasks;//Tasks not started
+
+            std::mutex lock;//Lock of the queue
+
+            std::condition_variable ready;//Signals new tasks or the end of the pool
+
+            bool stop;//The pool is being destroyed
+
+        /* Constructors, copy control */
+
+        public:
+
+            //Constructor with the number of threads (0 uses one per hardware thread)
+            explicit Wrk (unsigned nthreads=0);
+
+            //Pools own their threads, they can't be copied
+            Wrk (const Wrk &) = delete;
+            Wrk& operator= (const Wrk &) = delete;
+
+            //Destructor, runs the tasks left and joins the threads
+            ~Wrk();
+
+        /* Tasks */
+
+        public:
+
+            //Add a task to the queue
+            void post (Task t);
+
+            //Add a task to the queue, the future gets its result (or its exception)
+            template <class F>
+            std::future<std::invoke_result_t<F>> submit (F f)
+            {
+                auto task=std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::move(f));
+                std::future<std::invoke_result_t<F>> rv=task->get_future();
+                post([task]{(*task)();});
+                return rv;
+            }
+
+            //Number of threads
+            std::size_t size() const
+            {
+                return workers.size();
+            }
+
+            //Pool shared by the library, with one thread per hardware thread (created on the first use)
+            static Wrk& shared();
+
+        private:
+
+            //Loop of a worker thread
+            void work();
+    };
+
+}}//End of namespace
+
+//End of library
+#endif // _FDX_WRK_H_
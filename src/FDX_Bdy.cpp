@@ -0,0 +1,243 @@
+/*
+ * FDX_Bdy.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Bdy
+    Store of bodies in columns (SoA) addressed by generational handles
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Bdy.hpp"
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Body store
+    */
+
+    //Dense index of a slot without body
+    constexpr std::uint32_t Bdy_store::NO_DENSE;
+
+    /* Bodies */
+
+    //Add a body with the shape and speed given, returns its handle
+    Bdy_hdl Bdy_store::add (const Shp &s, const Vct &speed)
+    {
+        //Columns of the body
+        Vct c(s.get_pos_center());
+        Vct e(s.get_diagonal(),0.5), a(1,0);
+        if (s.get_tag()==Shp::Tag::crl)//Circles keep their radius as half size
+            e=Vct(s.get_size(),s.get_size());
+        else if (s.get_tag()==Shp::Tag::obb)//Oriented rectangles keep their own half size and axis
+        {
+            const Obb &o=static_cast<const Obb&>(s);
+            e=Vct(o.get_side(),0.5);
+            a=o.get_axis_x();
+        }
+        else if (s.get_tag()==Shp::Tag::cap)//Capsules keep their half length and radius, and their axis
+        {
+            const Cap &c=static_cast<const Cap&>(s);
+            e=Vct(0.5*(c.get_end_b()-c.get_end_a()).mod(),c.get_radius());
+            a=c.get_axis_x();
+        }
+
+        return add(s.get_tag(),c,e,a,speed);
+    }
+
+    //Add a body given by its columns, returns its handle
+    Bdy_hdl Bdy_store::add (Shp::Tag t, const Vct &center, const Vct &extent, const Vct &axis, const Vct &speed)
+    {
+        //Polygons and compounds are kept as their box, they must behave as the rectangle they are
+        if (t==Shp::Tag::pol||t==Shp::Tag::cmp)
+            t=Shp::Tag::rct;
+
+        //Get a slot
+        std::uint32_t slot;
+        if (!free_slots.empty())//Reuse a free slot, its generation was increased on removal
+        {
+            slot=free_slots.back();
+            free_slots.pop_back();
+        }
+        else//New slot
+        {
+            slot=static_cast<std::uint32_t>(dense.size());
+            dense.push_back(NO_DENSE);
+            gen.push_back(0);
+        }
+
+        //Append the body to the columns
+        dense[slot]=static_cast<std::uint32_t>(pos.size());
+        pos.push_back(center);
+        ext.push_back(extent);
+        axs.push_back(axis);
+        spd.push_back(speed);
+        tag.push_back(t);
+        owner.push_back(slot);
+
+        return Bdy_hdl{slot,gen[slot]};
+    }
+
+    //Remove a body, returns false if the handle was not valid
+    bool Bdy_store::remove (Bdy_hdl h)
+    {
+        if (!valid(h))
+            return false;
+
+        //Move the last body to the place of the removed one
+        std::uint32_t i=dense[h.index], last=static_cast<std::uint32_t>(pos.size()-1);
+        if (i!=last)
+        {
+            pos.set(i,pos.get(last));
+            ext.set(i,ext.get(last));
+            axs.set(i,axs.get(last));
+            spd.set(i,spd.get(last));
+            tag[i]=tag[last];
+            owner[i]=owner[last];
+            dense[owner[i]]=i;
+        }
+        pos.pop_back();
+        ext.pop_back();
+        axs.pop_back();
+        spd.pop_back();
+        tag.pop_back();
+        owner.pop_back();
+
+        //Free the slot, the new generation invalidates the old handles
+        dense[h.index]=NO_DENSE;
+        gen[h.index]++;
+        free_slots.push_back(h.index);
+        return true;
+    }
+
+    //Remove every body
+    void Bdy_store::clear()
+    {
+        for (std::size_t i=0;i<owner.size();i++)
+        {
+            dense[owner[i]]=NO_DENSE;
+            gen[owner[i]]++;
+            free_slots.push_back(owner[i]);
+        }
+        pos.clear();
+        ext.clear();
+        axs.clear();
+        spd.clear();
+        tag.clear();
+        owner.clear();
+    }
+
+    /* Adapters to the shapes */
+
+    //Build the shape of the body at a dense index in the buffer
+    const Shp& Bdy_store::shape (std::size_t i, Shp_buf &buf) const
+    {
+        Vct p(pos.get(i)), e(ext.get(i)), a(axs.get(i));
+        switch (tag[i])
+        {
+            case Shp::Tag::crl:
+                buf.crl=Crl(p,e.x);
+                return buf.crl;
+            case Shp::Tag::pnt:
+                buf.pnt=Pnt(p);
+                return buf.pnt;
+            case Shp::Tag::obb:
+                buf.obb=Obb(p,Vct(e,2),0);
+                buf.obb.set_axis_x(a);
+                return buf.obb;
+            case Shp::Tag::cap:
+                buf.cap=Cap(p-a*e.x,p+a*e.x,e.y);
+                return buf.cap;
+            default://Rectangles (polygons and compounds are stored as rectangles)
+                buf.rct=Rct(p-e,Vct(e,2));
+                return buf.rct;
+        }
+    }
+
+    //Contact between two bodies
+    bool Bdy_store::contact (Bdy_hdl a, Bdy_hdl b) const
+    {
+        Shp_buf ba,bb;
+        return shape(index(a),ba).contact(shape(index(b),bb));
+    }
+
+    //Time for the first body to hit the second at the given speed
+    Vct::Mod Bdy_store::tth (Bdy_hdl a, Bdy_hdl b, const Vct &speed) const
+    {
+        Shp_buf ba,bb;
+        return shape(index(a),ba).tth(shape(index(b),bb),speed);
+    }
+
+    //Movement of the first body against the second at the given speed
+    Vct Bdy_store::mov_against (Bdy_hdl a, Bdy_hdl b, const Vct &speed) const
+    {
+        Shp_buf ba,bb;
+        return shape(index(a),ba).mov_against(shape(index(b),bb),speed);
+    }
+
+    /* Batch kernels */
+
+    //Contact of n pairs of bodies given by their dense indices
+    void Bdy_store::contact (const std::uint32_t *a, const std::uint32_t *b, std::size_t n, bool *out) const
+    {
+        Shp_buf ba,bb;
+        for (std::size_t k=0;k<n;k++)
+            out[k]=shape(a[k],ba).contact(shape(b[k],bb));
+    }
+
+    //TTH of n pairs of bodies given by their dense indices, using the relative speed of the columns
+    void Bdy_store::tth (const std::uint32_t *a, const std::uint32_t *b, std::size_t n, Vct::Mod *out) const
+    {
+        Shp_buf ba,bb;
+        for (std::size_t k=0;k<n;k++)
+            out[k]=shape(a[k],ba).tth(shape(b[k],bb),spd.get(a[k])-spd.get(b[k]));
+    }
+
+    //Move every body by its speed multiplied by dt
+    void Bdy_store::integrate (Vct::Mod dt)
+    {
+        pos.add_scaled(spd,dt);
+    }
+
+    //Write the boxes of the bodies with dense indices in [first,last), in order from out
+    void Bdy_store::bounds (std::size_t first, std::size_t last, Box *out) const
+    {
+        const Coord *x=pos.x.data(), *y=pos.y.data();
+        const Coord *hx=ext.x.data(), *hy=ext.y.data();
+        const Coord *ax=axs.x.data(), *ay=axs.y.data();
+        const Shp::Tag *t=tag.data();
+        for (std::size_t i=first;i<last;i++)
+            out[i-first]=bounds(t[i],x[i],y[i],hx[i],hy[i],ax[i],ay[i]);
+    }
+
+}}//End of namespace
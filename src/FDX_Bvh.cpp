@@ -0,0 +1,134 @@
+/*
+ * FDX_Bvh.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Bvh
+    Bounding volume hierarchy of axis aligned boxes
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Bvh.hpp"
+
+//Median split
+#include <algorithm>
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Bounding volume hierarchy
+    */
+
+    constexpr std::uint32_t Bvh::LEAF_SIZE;
+
+    /* Building */
+
+    //Build the hierarchy over the given boxes
+    void Bvh::build (const std::vector<Box> &boxes)
+    {
+        clear();
+        if (boxes.empty())
+            return;
+
+        items.resize(boxes.size());
+        for (std::uint32_t i=0;i<items.size();i++)
+            items[i]=i;
+
+        nodes.reserve(2*boxes.size()/LEAF_SIZE+1);
+        nodes.push_back(Node());
+        build_node(0,0,static_cast<std::uint32_t>(items.size()),boxes);
+    }
+
+    //Build the subtree of the node with the items in [first,first+count)
+    void Bvh::build_node (std::uint32_t n, std::uint32_t first, std::uint32_t count, const std::vector<Box> &boxes)
+    {
+        //Box of the node
+        Box b(boxes[items[first]]);
+        Box centers(b.get_center(),Vct());
+        for (std::uint32_t i=first+1;i<first+count;i++)
+        {
+            b=Box::max_union(b,boxes[items[i]]);
+            centers=Box::max_union(centers,Box(boxes[items[i]].get_center(),Vct()));
+        }
+        nodes[n].box=b;
+
+        //Small enough, make a leaf
+        //The depth is bounded by the median split, the stack of the traversals (64) is never exceeded
+        if (count<=LEAF_SIZE)
+        {
+            nodes[n].first=first;
+            nodes[n].count=count;
+            return;
+        }
+
+        //Split by the median of the centers on the longest axis
+        bool split_x=centers.x.get_size()>=centers.y.get_size();
+        std::uint32_t mid=first+count/2;
+        std::nth_element(items.begin()+first,items.begin()+mid,items.begin()+first+count,
+            [&boxes,split_x](std::uint32_t a, std::uint32_t b)
+            {
+                return split_x?
+                    boxes[a].x.get_middle()<boxes[b].x.get_middle():
+                    boxes[a].y.get_middle()<boxes[b].y.get_middle();
+            });
+
+        //Children
+        std::uint32_t left=static_cast<std::uint32_t>(nodes.size());
+        nodes[n].first=left;
+        nodes[n].count=0;
+        nodes.push_back(Node());
+        nodes.push_back(Node());
+        build_node(left,first,mid-first,boxes);
+        build_node(left+1,mid,first+count-mid,boxes);
+    }
+
+    //Update the boxes of the nodes after the items moved
+    void Bvh::refit (const std::vector<Box> &boxes)
+    {
+        //Children are always after their parent, walk backwards
+        for (std::size_t k=nodes.size();k-->0;)
+        {
+            Node &n=nodes[k];
+            if (n.leaf())
+            {
+                Box b(boxes[items[n.first]]);
+                for (std::uint32_t i=n.first+1;i<n.first+n.count;i++)
+                    b=Box::max_union(b,boxes[items[i]]);
+                n.box=b;
+            }
+            else
+                n.box=Box::max_union(nodes[n.first].box,nodes[n.first+1].box);
+        }
+    }
+
+}}//End of namespace
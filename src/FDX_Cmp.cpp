@@ -0,0 +1,625 @@
+/*
+ * FDX_Cmp.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Cmp
+    Compound shape of parts in local coordinates
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Cmp.hpp"
+
+//Square root
+#include <cmath>
+
+//Distance of an empty compound
+#include <limits>
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Compound
+    */
+
+    /* Traversal */
+
+    //Part hit first by the compound moving at the given speed against a shape whose local box is given
+    template <class F>
+    std::size_t Cmp::first (const Box &b, const Vct &speed, F tth, Vct::Mod &t) const
+    {
+        std::size_t hit=parts.size();
+        t=-1;
+        if (bvh.empty())
+            return hit;
+
+        //Time at which a box of the compound enters the box of the shape, negative if never
+        auto enter=[&b,&speed](const Box &c)->Vct::Mod
+        {
+            Set ttc(c.tth(b,speed));
+            if (!ttc.valid()||ttc.get_max()<0)
+                return -1;
+            return std::max(0.0,ttc.get_min());
+        };
+
+        //Check if a time can't beat the best hit
+        auto late=[&t](Vct::Mod te)
+        {
+            return te<0||(t>=0&&te>=t);
+        };
+
+        //Nodes to visit with the time at which they enter the box of the shape
+        struct Entry
+        {
+            std::uint32_t n;
+            Vct::Mod t;
+        };
+        Entry stack[64];
+        int top=0;
+
+        Vct::Mod troot=enter(bvh.node(0).box);
+        if (troot>=0)
+            stack[top++]=Entry{0,troot};
+
+        while (top)
+        {
+            Entry e=stack[--top];
+            if (late(e.t))
+                continue;
+
+            const Bvh::Node &node=bvh.node(e.n);
+            if (node.leaf())
+            {
+                for (std::uint32_t k=node.first;k<node.first+node.count;k++)
+                {
+                    std::uint32_t i=bvh.item(k);
+                    if (late(enter(boxes[i])))
+                        continue;
+                    Vct::Mod ti=tth(i);
+                    if (!late(ti))
+                    {
+                        t=ti;
+                        hit=i;
+                    }
+                }
+            }
+            else
+            {
+                //Visit the closest child first (pushed last)
+                Entry l{node.first,enter(bvh.node(node.first).box)}, r{node.first+1,enter(bvh.node(node.first+1).box)};
+                if (l.t>r.t)
+                    std::swap(l,r);
+                if (!late(r.t))
+                    stack[top++]=r;
+                if (!late(l.t))
+                    stack[top++]=l;
+            }
+        }
+        return hit;
+    }
+
+    //Call f with a copy of the part moved to the global coordinates
+    template <class F>
+    void Cmp::global_part (std::size_t i, F f) const
+    {
+        const Part &p=parts[i];
+        switch (p.tag)
+        {
+            case Tag::crl:
+            {
+                Crl c(crl[p.i]);
+                c.mov(r);
+                f(c);
+                return;
+            }
+            case Tag::pnt:
+            {
+                Pnt c(pnt[p.i]);
+                c.mov(r);
+                f(c);
+                return;
+            }
+            case Tag::rct:
+            {
+                Rct c(rct[p.i]);
+                c.mov(r);
+                f(c);
+                return;
+            }
+            case Tag::obb:
+            {
+                Obb c(obb[p.i]);
+                c.mov(r);
+                f(c);
+                return;
+            }
+            case Tag::pol:
+            {
+                Pol c(pol[p.i]);
+                c.mov(r);
+                f(c);
+                return;
+            }
+            default:
+            {
+                Cap c(cap[p.i]);
+                c.mov(r);
+                f(c);
+                return;
+            }
+        }
+    }
+
+    //TTH of a part, moved to the global coordinates, against a shape
+    Vct::Mod Cmp::tth_global (std::size_t i, const Shp &s, const Vct &speed) const
+    {
+        Vct::Mod t;
+        global_part(i,[&s,&speed,&t](const Shp &p)
+        {
+            t=p.tth(s,speed);
+        });
+        return t;
+    }
+
+    //Contact with a shape of a concrete type
+    template <class S>
+    bool Cmp::contact_shp (const S &s) const
+    {
+        S l(s);
+        l.mov(-r);
+        return !overlap(Box(l),[this,&l](std::uint32_t i)
+        {
+            return !get_part(i).contact(l);
+        });
+    }
+
+    //TTH a shape of a concrete type
+    template <class S>
+    Vct::Mod Cmp::tth_shp (const S &s, const Vct &speed) const
+    {
+        S l(s);
+        l.mov(-r);
+        Vct::Mod t;
+        first(Box(l),speed,[this,&l,&speed](std::size_t i)
+        {
+            return get_part(i).tth(l,speed);
+        },t);
+        return t;
+    }
+
+    //TOI a shape of a concrete type
+    template <class S>
+    Toi Cmp::toi_shp (const S &s, const Vct &speed) const
+    {
+        S l(s);
+        l.mov(-r);
+        Vct::Mod t;
+        std::size_t i=first(Box(l),speed,[this,&l,&speed](std::size_t i)
+        {
+            return get_part(i).tth(l,speed);
+        },t);
+        if (i==parts.size())
+            return Toi{-1,Vct(),Vct(),Toi::Feature::none};
+
+        //Back to the global coordinates
+        Toi toi=get_part(i).toi(l,speed);
+        toi.point+=r;
+        return toi;
+    }
+
+    //Movement against a shape of a concrete type
+    template <class S>
+    Vct Cmp::mov_against_shp (const S &s, const Vct &speed) const
+    {
+        S l(s);
+        l.mov(-r);
+        return clip(Box(l),speed,[this,&l](std::size_t i, const Vct &m)
+        {
+            return get_part(i).tth(l,m);
+        },
+        [this,&l](std::size_t i, const Vct &m)
+        {
+            return get_part(i).mov_against(l,m);
+        });
+    }
+
+    //Movement limited by the parts
+    template <class T, class M>
+    Vct Cmp::clip (const Box &b, const Vct &speed, T tth, M mov) const
+    {
+        //Parts hit in the tick that limit the movement (touching parts the movement slides along don't)
+        auto limit=[&tth,&mov](std::size_t i, const Vct &m)
+        {
+            Vct::Mod t=tth(i,m);
+            return t<0||t>=1||mov(i,m)==m?-1:t;
+        };
+
+        //Each limit may turn the slide into any part, even one that limited it before
+        Vct m(speed);
+        for (std::size_t k=0;k<=parts.size();k++)
+        {
+            Vct::Mod t;
+            std::size_t i=first(b,m,[&limit,&m](std::size_t i)
+            {
+                return limit(i,m);
+            },t);
+            if (i==parts.size())
+                return m;
+            m=mov(i,m);
+        }
+
+        //Still limited after a limit for each part (a slide into a corner between parts), stop at the first hit
+        Vct::Mod t;
+        if (first(b,m,[&limit,&m](std::size_t i){return limit(i,m);},t)!=parts.size())
+            m*=t;
+        return m;
+    }
+
+    /* Parts */
+
+    //Get a part, in local coordinates
+    const Shp& Cmp::get_part (std::size_t i) const
+    {
+        const Part &p=parts[i];
+        switch (p.tag)
+        {
+            case Tag::crl:
+                return crl[p.i];
+            case Tag::pnt:
+                return pnt[p.i];
+            case Tag::rct:
+                return rct[p.i];
+            case Tag::obb:
+                return obb[p.i];
+            case Tag::pol:
+                return pol[p.i];
+            default:
+                return cap[p.i];
+        }
+    }
+
+    //Get a part to change it, in local coordinates
+    Shp& Cmp::part (std::size_t i)
+    {
+        return const_cast<Shp&>(static_cast<const Cmp&>(*this).get_part(i));
+    }
+
+    //Remove every part
+    void Cmp::clear()
+    {
+        crl.clear();
+        pnt.clear();
+        rct.clear();
+        obb.clear();
+        pol.clear();
+        cap.clear();
+        parts.clear();
+        build();
+    }
+
+    //Register the last part of a type, returns its index
+    std::size_t Cmp::push (Tag tag, std::size_t i)
+    {
+        parts.push_back(Part{tag,static_cast<std::uint32_t>(i)});
+        build();
+        return parts.size()-1;
+    }
+
+    //Update the boxes, the bounds and the hierarchy after the parts changed
+    void Cmp::build()
+    {
+        boxes.resize(parts.size());
+        bounds=Box();
+        rad=0;
+        for (std::size_t i=0;i<parts.size();i++)
+        {
+            const Shp &s=get_part(i);
+            boxes[i]=s.get_bounds();
+            bounds=i?Box::max_union(bounds,boxes[i]):boxes[i];
+            rad=std::max(rad,s.get_pos_center().mod()+s.get_size());
+        }
+        bvh.build(boxes);
+        touch();
+    }
+
+    /* Size */
+
+    //Scale the parts around the origin
+    void Cmp::scale (Vct::Mod k)
+    {
+        for (std::size_t i=0;i<parts.size();i++)
+        {
+            Shp &s=part(i);
+            Vct c(s.get_pos_center()*k);
+            if (s.get_tag()==Tag::crl)//The diagonal of a circle doesn't keep its radius
+                s.set_size(s.get_size()*k);
+            else
+                s.set_diagonal(s.get_diagonal()*k);
+            s.set_pos_center(c);//After the size, some shapes keep their corner when resized
+        }
+        build();
+    }
+
+    /* Contact */
+
+    //Contact with a generic shape
+    bool Cmp::contact (const Shp &s) const
+    {
+        if (s.get_tag()!=Tag::cmp)
+            return s.contact(*this);
+
+        //Parts of this compound against the other one
+        Box b(s.get_pos_corner()-r,s.get_diagonal());
+        return !overlap(b,[this,&s](std::uint32_t i)
+        {
+            bool hit;
+            global_part(i,[&s,&hit](const Shp &p)
+            {
+                hit=p.contact(s);
+            });
+            return !hit;
+        });
+    }
+
+    //Contact with a circle
+    bool Cmp::contact (const Crl &c) const
+    {
+        return contact_shp(c);
+    }
+
+    //Contact with a point
+    bool Cmp::contact (const Pnt &p) const
+    {
+        return contact_shp(p);
+    }
+
+    //Contact with a rectangle
+    bool Cmp::contact (const Rct &r) const
+    {
+        return contact_shp(r);
+    }
+
+    //Contact with an oriented rectangle
+    bool Cmp::contact (const Obb &o) const
+    {
+        return contact_shp(o);
+    }
+
+    //Contact with a convex polygon
+    bool Cmp::contact (const Pol &p) const
+    {
+        return contact_shp(p);
+    }
+
+    //Contact with a capsule
+    bool Cmp::contact (const Cap &c) const
+    {
+        return contact_shp(c);
+    }
+
+    /* Distance */
+
+    //Squared distance from a point to the surface of the shape (0 if the point is inside)
+    Vct::Mod Cmp::sq_dist (const Vct &p) const
+    {
+        Vct l(p-r);
+        Vct::Mod d=-1;
+        for (std::size_t i=0;i<parts.size();i++)
+            if (d<0||boxes[i].sq_dist(l)<d)//Skip the parts that can't be closer
+            {
+                Vct::Mod di=get_part(i).sq_dist(l);
+                if (d<0||di<d)
+                    d=di;
+            }
+
+        //Without parts there's no surface
+        if (d<0)
+            return std::numeric_limits<Vct::Mod>::infinity();
+        return std::max(d,0.0);
+    }
+
+    /* Time to hit */
+
+    //TTH a generic shape at a given speed
+    Vct::Mod Cmp::tth (const Shp &s, const Vct &speed) const
+    {
+        if (s.get_tag()!=Tag::cmp)
+            return s.tth(*this,-speed);
+
+        //Parts of this compound against the other one
+        Vct::Mod t;
+        first(Box(s.get_pos_corner()-r,s.get_diagonal()),speed,[this,&s,&speed](std::size_t i)
+        {
+            return tth_global(i,s,speed);
+        },t);
+        return t;
+    }
+
+    //TTH a circle at a given speed
+    Vct::Mod Cmp::tth (const Crl &c, const Vct &speed) const
+    {
+        return tth_shp(c,speed);
+    }
+
+    //TTH a point at a given speed
+    Vct::Mod Cmp::tth (const Pnt &p, const Vct &speed) const
+    {
+        return tth_shp(p,speed);
+    }
+
+    //TTH a rectangle at a given speed
+    Vct::Mod Cmp::tth (const Rct &r, const Vct &speed) const
+    {
+        return tth_shp(r,speed);
+    }
+
+    //TTH an oriented rectangle at a given speed
+    Vct::Mod Cmp::tth (const Obb &o, const Vct &speed) const
+    {
+        return tth_shp(o,speed);
+    }
+
+    //TTH a convex polygon at a given speed
+    Vct::Mod Cmp::tth (const Pol &p, const Vct &speed) const
+    {
+        return tth_shp(p,speed);
+    }
+
+    //TTH a capsule at a given speed
+    Vct::Mod Cmp::tth (const Cap &c, const Vct &speed) const
+    {
+        return tth_shp(c,speed);
+    }
+
+    /* Time of impact */
+
+    //TOI a generic shape at a given speed
+    Toi Cmp::toi (const Shp &s, const Vct &speed) const
+    {
+        if (s.get_tag()!=Tag::cmp)
+        {
+            return flip_toi(s.toi(*this,-speed),speed);
+        }
+
+        //Parts of this compound against the other one, the first part hit gives the TOI
+        Vct::Mod t;
+        std::size_t i=first(Box(s.get_pos_corner()-r,s.get_diagonal()),speed,[this,&s,&speed](std::size_t i)
+        {
+            return tth_global(i,s,speed);
+        },t);
+        Toi toi{-1,Vct(),Vct(),Toi::Feature::none};
+        if (i<parts.size())
+            global_part(i,[&s,&speed,&toi](const Shp &p)
+            {
+                toi=p.toi(s,speed);
+            });
+        return toi;
+    }
+
+    //TOI a circle at a given speed
+    Toi Cmp::toi (const Crl &c, const Vct &speed) const
+    {
+        return toi_shp(c,speed);
+    }
+
+    //TOI a point at a given speed
+    Toi Cmp::toi (const Pnt &p, const Vct &speed) const
+    {
+        return toi_shp(p,speed);
+    }
+
+    //TOI a rectangle at a given speed
+    Toi Cmp::toi (const Rct &r, const Vct &speed) const
+    {
+        return toi_shp(r,speed);
+    }
+
+    //TOI an oriented rectangle at a given speed
+    Toi Cmp::toi (const Obb &o, const Vct &speed) const
+    {
+        return toi_shp(o,speed);
+    }
+
+    //TOI a convex polygon at a given speed
+    Toi Cmp::toi (const Pol &p, const Vct &speed) const
+    {
+        return toi_shp(p,speed);
+    }
+
+    //TOI a capsule at a given speed
+    Toi Cmp::toi (const Cap &c, const Vct &speed) const
+    {
+        return toi_shp(c,speed);
+    }
+
+    /* Movement against a shape */
+
+    //Movement against a generic shape at a given speed
+    Vct Cmp::mov_against (const Shp &s, const Vct &speed) const
+    {
+        if (s.get_tag()!=Tag::cmp)
+            return -s.mov_against(*this,-speed);
+
+        //Parts of this compound against the other one
+        return clip(Box(s.get_pos_corner()-r,s.get_diagonal()),speed,[this,&s](std::size_t i, const Vct &m)
+        {
+            return tth_global(i,s,m);
+        },
+        [this,&s](std::size_t i, const Vct &m)
+        {
+            Vct c;
+            global_part(i,[&s,&m,&c](const Shp &p)
+            {
+                c=p.mov_against(s,m);
+            });
+            return c;
+        });
+    }
+
+    //Movement against a circle at a given speed
+    Vct Cmp::mov_against (const Crl &c, const Vct &speed) const
+    {
+        return mov_against_shp(c,speed);
+    }
+
+    //Movement against a point at a given speed
+    Vct Cmp::mov_against (const Pnt &p, const Vct &speed) const
+    {
+        return mov_against_shp(p,speed);
+    }
+
+    //Movement against a rectangle at a given speed
+    Vct Cmp::mov_against (const Rct &r, const Vct &speed) const
+    {
+        return mov_against_shp(r,speed);
+    }
+
+    //Movement against an oriented rectangle at a given speed
+    Vct Cmp::mov_against (const Obb &o, const Vct &speed) const
+    {
+        return mov_against_shp(o,speed);
+    }
+
+    //Movement against a convex polygon at a given speed
+    Vct Cmp::mov_against (const Pol &p, const Vct &speed) const
+    {
+        return mov_against_shp(p,speed);
+    }
+
+    //Movement against a capsule at a given speed
+    Vct Cmp::mov_against (const Cap &c, const Vct &speed) const
+    {
+        return mov_against_shp(c,speed);
+    }
+
+}}//End of namespace
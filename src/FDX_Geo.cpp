@@ -40,6 +40,15 @@
 //Header file
 #include "../include/FDX_Geo.hpp"
 
+//Hot path counters
+#include "../include/FDX_Sts.hpp"
+
+//Infinite times
+#include <limits>
+
+//Sorting of the Minkowski differences
+#include <algorithm>
+
 namespace fdx{ namespace arrow
 {
     /*
@@ -53,18 +62,8 @@ namespace fdx{ namespace arrow
     //Contact between two shapes (Crl/Pnt, Crl/Pnt)
     bool contact_crlpnt_crlpnt (const Shp& s1, const Shp& s2)
     {
-        Vct::Mod dist=s1.get_size()+s2.get_size();//Size of the shapes (radius for Crl, 0 for Pnt)
-        return ((s1.get_pos_center()-s2.get_pos_center()).sq_mod())<(dist*dist);//If the distance between centers is less than the size, the shapes are in contact
-    }
-
-    //Get the minimum absolute value of a set
-    Vct::Mod min_abs_set (Vct::Mod min_set, Vct::Mod max_set)
-    {
-        //If 0 is on the set, it will always be the minimum
-        if (min_set<=0&&0<=max_set)//0 is on the set, return it
-            return 0;
-        else//0 is not in the set, the min abs value is one of the extremes
-            return min_set>0?min_set:-max_set;
+        FDX_STS_CALL(contact,crlpnt_crlpnt);
+        return arrow::contact_crlpnt_crlpnt(s1.get_pos_center(),s1.get_size(),s2.get_pos_center(),s2.get_size());
     }
 
     //Get the minimum distance between rectangle and a circle/point
@@ -80,21 +79,389 @@ namespace fdx{ namespace arrow
     //Contact between a rectangle and a circle
     bool contact_crlpnt_rct (const Shp &s, const Rct &r)
     {
-        return mindist_crlpnt_rct(s,r).sq_mod()<=s.get_size()*s.get_size();
+        FDX_STS_CALL(contact,crlpnt_rct);
+        return arrow::contact_crlpnt_rct(s.get_pos_center(),s.get_size(),r.get_pos_corner(),r.get_diagonal());
     }
 
     //Contact between two rects
     bool contact_rct_rct (const Rct &r1, const Rct &r2)
     {
-        //Distance between the centers
-        Vct rdist(r1.get_pos_center()-r2.get_pos_center());
+        FDX_STS_CALL(contact,rct_rct);
+        return arrow::contact_rct_rct(r1.get_pos_center(),r1.get_diagonal(),r2.get_pos_center(),r2.get_diagonal());
+    }
+
+    //Dot product of two vectors
+    Vct::Coord dot (const Vct &a, const Vct &b)
+    {
+        return a.x*b.x+a.y*b.y;
+    }
+
+    //Cross product of two vectors (Z coordinate)
+    Vct::Coord cross (const Vct &a, const Vct &b)
+    {
+        return a.x*b.y-a.y*b.x;
+    }
+
+    //Vector in the frame of an oriented rectangle (only rotated, the origin is kept)
+    Vct to_local_obb (const Obb &o, const Vct &v)
+    {
+        return Vct(dot(v,o.get_axis_x()),dot(v,o.get_axis_y()));
+    }
+
+    //Vector in the frame of an oriented rectangle back to the world frame
+    Vct to_world_obb (const Obb &o, const Vct &v)
+    {
+        return o.get_axis_x()*v.x+o.get_axis_y()*v.y;
+    }
+
+    //Circle/point in the frame of an oriented rectangle (a point is a circle of radius 0)
+    Crl local_crlpnt_obb (const Shp &s, const Obb &o)
+    {
+        return Crl(to_local_obb(o,s.get_pos_center()-o.get_pos_center()),s.get_size());
+    }
+
+    //Oriented rectangle in its own frame, centered on the origin
+    Rct local_obb (const Obb &o)
+    {
+        return Rct(-0.5*o.get_side(),o.get_side());
+    }
+
+    //Contact between a circle/point and an oriented rectangle (as a rectangle in its own frame)
+    bool contact_crlpnt_obb (const Shp &s, const Obb &o)
+    {
+        return contact_crlpnt_rct(local_crlpnt_obb(s,o),local_obb(o));
+    }
+
+    //Projections of two oriented rectangles on their separating axes (the X and Y axes of both)
+    struct Sat_obb
+    {
+        Vct::Coord ax[4], ay[4];//Axes
+        Vct::Coord c[4];//Distance between the centers, from the second to the first
+        Vct::Coord r[4];//Half size of both rectangles combined
+        Vct::Coord v[4];//Speed of the first rectangle
+        Set tt[4];//Times of contact
+    };
+
+    //Project two oriented rectangles, the first moving at the given speed, on their separating axes
+    void sat_obb_obb (const Obb &o1, const Obb &o2, const Vct &speed, Sat_obb &p)
+    {
+        Vct u1(o1.get_axis_x()), u2(o2.get_axis_x());
+        Vct h1(o1.get_side(),0.5), h2(o2.get_side(),0.5);
+        Vct d(o1.get_pos_center()-o2.get_pos_center());
+
+        //Axes
+        p.ax[0]=u1.x; p.ay[0]=u1.y;
+        p.ax[1]=-u1.y; p.ay[1]=u1.x;
+        p.ax[2]=u2.x; p.ay[2]=u2.y;
+        p.ax[3]=-u2.y; p.ay[3]=u2.x;
+
+        //Same operations on every axis, so the loop can be vectorized
+        for (int i=0;i<4;i++)
+        {
+            p.c[i]=d.x*p.ax[i]+d.y*p.ay[i];
+            p.r[i]=h1.x*std::abs(u1.x*p.ax[i]+u1.y*p.ay[i])+h1.y*std::abs(u1.x*p.ay[i]-u1.y*p.ax[i])
+                  +h2.x*std::abs(u2.x*p.ax[i]+u2.y*p.ay[i])+h2.y*std::abs(u2.x*p.ay[i]-u2.y*p.ax[i]);
+            p.v[i]=speed.x*p.ax[i]+speed.y*p.ay[i];
+        }
+    }
+
+    //Contact between two oriented rectangles (no separating axis)
+    bool contact_obb_obb (const Obb &o1, const Obb &o2)
+    {
+        FDX_STS_CALL(contact,obb_obb);
+
+        Sat_obb p;
+        sat_obb_obb(o1,o2,Vct(),p);
+
+        //Check every axis without branching
+        bool sep=false;
+        for (int i=0;i<4;i++)
+            sep|=std::abs(p.c[i])>p.r[i];
+        return !sep;
+    }
+
+    //Projection of a polygon on an axis
+    Set proj_pol (const Pol &p, const Vct &a)
+    {
+        const Vct::Coord *x=p.vertex_x(), *y=p.vertex_y();
+        Vct::Coord lo=std::numeric_limits<Vct::Coord>::infinity(), hi=-lo;
+        for (std::size_t i=0;i<p.get_count();i++)
+        {
+            Vct::Coord d=x[i]*a.x+y[i]*a.y;
+            lo=std::min(lo,d);
+            hi=std::max(hi,d);
+        }
+        Vct::Coord c=dot(p.get_pos_center(),a);
+        return Set(c+lo,c+hi);
+    }
+
+    //Vertices and normals of a convex polygon, as columns relative to a point
+    struct Pol_view
+    {
+        const Vct::Coord *x, *y;//Vertices, counter clockwise
+        const Vct::Coord *nx, *ny;//Unitary outer normal of each side
+        std::size_t n;//Number of vertices
+    };
+
+    //Columns of a polygon, relative to its center
+    Pol_view view_pol (const Pol &p)
+    {
+        return Pol_view{p.vertex_x(),p.vertex_y(),p.normal_x(),p.normal_y(),p.get_count()};
+    }
+
+    //Check if a point is inside a polygon (with area), side gets the side with the greatest separation
+    bool inside_pol (const Pol_view &p, const Vct &q, std::size_t &side)
+    {
+        Vct::Coord sep=-std::numeric_limits<Vct::Coord>::infinity();
+        side=0;
+        for (std::size_t i=0;i<p.n;i++)
+        {
+            Vct::Coord d=(q.x-p.x[i])*p.nx[i]+(q.y-p.y[i])*p.ny[i];
+            if (d>sep)
+            {
+                sep=d;
+                side=i;
+            }
+        }
+        return p.n>=3&&sep<=0;
+    }
+
+    /*Squared distance from a point to the sides of a polygon
+      side gets the closest side, end if the closest point is its first vertex, and closest the point*/
+    Vct::Mod closest_pol (const Pol_view &p, const Vct &q, std::size_t &side, bool &end, Vct &closest)
+    {
+        const Vct::Coord *x=p.x, *y=p.y;
+        std::size_t n=p.n;
+        Vct::Mod best=std::numeric_limits<Vct::Mod>::infinity();
+        for (std::size_t i=0;i<n;i++)
+        {
+            //Side from this vertex to the next one
+            std::size_t j=i+1<n?i+1:0;
+            Vct a(x[i],y[i]), e(x[j]-x[i],y[j]-y[i]);
+
+            //Closest point of the side
+            Vct::Mod k=e?dot(q-a,e)/e.sq_mod():0;
+            k=std::max(Vct::Mod(0),std::min(Vct::Mod(1),k));
+            Vct c(a+e*k);
+            Vct::Mod d=(q-c).sq_mod();
+            if (d<best)
+            {
+                best=d;
+                closest=c;
+                if (k<=0)//First vertex
+                {
+                    side=i;
+                    end=true;
+                }
+                else if (k>=1)//Last vertex, the first of the next side
+                {
+                    side=j;
+                    end=true;
+                }
+                else
+                {
+                    side=i;
+                    end=false;
+                }
+            }
+        }
+        return best;
+    }
+
+    //Contact between a circle/point and a polygon
+    bool contact_crlpnt_pol (const Shp &s, const Pol &p)
+    {
+        FDX_STS_CALL(contact,crlpnt_pol);
+
+        if (!p.get_count())
+            return false;
+
+        //Center inside the polygon, or close enough to a side
+        Pol_view v(view_pol(p));
+        Vct q(s.get_pos_center()-p.get_pos_center());
+        std::size_t side;
+        bool end;
+        Vct c;
+        return inside_pol(v,q,side)||closest_pol(v,q,side,end,c)<=s.get_size()*s.get_size();
+    }
+
+    //Contact between two polygons (no separating axis among the normals of both)
+    bool contact_pol_pol (const Pol &p1, const Pol &p2)
+    {
+        FDX_STS_CALL(contact,pol_pol);
+
+        if (!p1.get_count()||!p2.get_count())
+            return false;
+
+        for (int k=0;k<2;k++)
+        {
+            const Pol &p=k?p2:p1;
+            for (std::size_t i=0;i<p.get_count();i++)
+            {
+                Vct a(p.get_normal(i));
+                Set s1(proj_pol(p1,a)), s2(proj_pol(p2,a));
+                if (s1.get_max()<s2.get_min()||s2.get_max()<s1.get_min())
+                    return false;
+            }
+        }
+        return true;
+    }
+
+    //Core of a shape: the shape is the convex hull of the points rounded by the radius returned
+    Vct::Mod core_shp (const Shp &s, std::vector<Vct> &pts)
+    {
+        pts.clear();
+        switch (s.get_tag())
+        {
+            case Shp::Tag::rct:
+            {
+                Vct c(s.get_pos_corner()), d(s.get_diagonal());
+                pts.push_back(c);
+                pts.push_back(c+Vct(d.x,0));
+                pts.push_back(c+d);
+                pts.push_back(c+Vct(0,d.y));
+                return 0;
+            }
+
+            case Shp::Tag::obb:
+            {
+                const Obb &o=static_cast<const Obb&>(s);
+                Vct c(o.get_pos_center());
+                Vct u(o.get_axis_x(),0.5*o.get_side().x), v(o.get_axis_y(),0.5*o.get_side().y);
+                pts.push_back(c-u-v);
+                pts.push_back(c+u-v);
+                pts.push_back(c+u+v);
+                pts.push_back(c-u+v);
+                return 0;
+            }
+
+            case Shp::Tag::pol:
+            {
+                const Pol &p=static_cast<const Pol&>(s);
+                for (std::size_t i=0;i<p.get_count();i++)
+                    pts.push_back(p.get_vertex(i));
+                return 0;
+            }
+
+            case Shp::Tag::cap:
+            {
+                const Cap &c=static_cast<const Cap&>(s);
+                pts.push_back(c.get_end_a());
+                pts.push_back(c.get_end_b());
+                return c.get_radius();
+            }
+
+            default://Circles and points
+            {
+                pts.push_back(s.get_pos_center());
+                return s.get_size();
+            }
+        }
+    }
+
+    /*Minkowski difference of the cores of two shapes (points of the second minus points of the first)
+      The shapes are in contact when the origin is inside the difference rounded by the sum of their radii*/
+    struct Mink
+    {
+        std::vector<Vct> a, b;//Core points of the shapes
+        Vct::Mod ra, rb;//Radius of the shapes
+
+        std::vector<Vct::Coord> x, y;//Vertices of the difference, counter clockwise
+        std::vector<Vct::Coord> nx, ny;//Unitary outer normal of each side
+        std::vector<std::uint32_t> ib;//Point of the second shape that gives each vertex
+    };
+
+    //Columns of a Minkowski difference
+    Pol_view view_mink (const Mink &m)
+    {
+        return Pol_view{m.x.data(),m.y.data(),m.nx.data(),m.ny.data(),m.x.size()};
+    }
+
+    //Build the Minkowski difference of two shapes (convex hull by a monotone chain), in the scratch storage of the thread
+    const Mink& mink_shp (const Shp &s1, const Shp &s2)
+    {
+        typedef std::pair<Vct,std::uint32_t> Diff;//Difference and its point of the second shape
+
+        //Scratch storage of the thread, reused between calls
+        static thread_local Mink m;
+        static thread_local std::vector<Diff> d;
+        static thread_local std::vector<std::size_t> h;
+
+        m.ra=core_shp(s1,m.a);
+        m.rb=core_shp(s2,m.b);
+
+        //Every difference, sorted by X and then Y
+        d.clear();
+        for (std::uint32_t i=0;i<m.b.size();i++)
+            for (std::size_t j=0;j<m.a.size();j++)
+                d.push_back(Diff(m.b[i]-m.a[j],i));
+        std::sort(d.begin(),d.end(),[](const Diff &p, const Diff &q)
+        {
+            return p.first.x<q.first.x||(p.first.x==q.first.x&&p.first.y<q.first.y);
+        });
+
+        //Lower and upper chains, only turns to the left are kept
+        std::size_t n=d.size(), k=0;
+        h.resize(2*n);
+        auto left=[](const Vct &o, const Vct &p, const Vct &q)
+        {
+            return cross(p-o,q-o)>0;
+        };
+        for (std::size_t i=0;i<n;i++)
+        {
+            while (k>=2&&!left(d[h[k-2]].first,d[h[k-1]].first,d[i].first))
+                k--;
+            h[k++]=i;
+        }
+        for (std::size_t i=n?n-1:0,lo=k+1;i>0;i--)
+        {
+            while (k>=lo&&!left(d[h[k-2]].first,d[h[k-1]].first,d[i-1].first))
+                k--;
+            h[k++]=i-1;
+        }
+        if (k>1)
+            k--;//The last one is the first one
+
+        //Vertices and normals
+        m.x.resize(k);
+        m.y.resize(k);
+        m.nx.resize(k);
+        m.ny.resize(k);
+        m.ib.resize(k);
+        for (std::size_t i=0;i<k;i++)
+        {
+            m.x[i]=d[h[i]].first.x;
+            m.y[i]=d[h[i]].first.y;
+            m.ib[i]=d[h[i]].second;
+        }
+        for (std::size_t i=0;i<k;i++)
+        {
+            std::size_t j=i+1<k?i+1:0;
+            Vct e(m.x[j]-m.x[i],m.y[j]-m.y[i]);
+            if (e)
+                e.unitary();
+            m.nx[i]=e.y;
+            m.ny[i]=-e.x;
+        }
+        return m;
+    }
 
-        //Size of the two rectangles combined
-        Vct rsz(r1.get_diagonal()+r2.get_diagonal());
-        rsz*=(0.5f);//Get the half size, not the full size
+    //Contact of the shapes of a Minkowski difference (the origin is inside it, once rounded)
+    bool contact_mink (const Mink &m)
+    {
+        Pol_view v(view_mink(m));
+        std::size_t side;
+        bool end;
+        Vct c;
+        Vct::Mod rr=m.ra+m.rb;
+        return inside_pol(v,Vct(),side)||closest_pol(v,Vct(),side,end,c)<=rr*rr;
+    }
 
-        //Check for contact (size is less than the distance)
-        return ((std::abs(rdist.x)<=rsz.x)&&(std::abs(rdist.y)<=rsz.y));
+    //Contact between a capsule and another shape (or any two shapes, through their cores)
+    bool contact_cap (const Shp &s1, const Shp &s2)
+    {
+        FDX_STS_CALL(contact,cap_shp);
+        return contact_mink(mink_shp(s1,s2));
     }
 
     /*TTH*/
@@ -104,9 +471,14 @@ namespace fdx{ namespace arrow
     //(Crl/Pnt, Crl/Pnt)
     Vct::Mod tth_crlpnt_crlpnt (const Shp& s1, const Shp& s2, const Vct& speed)
     {
+        FDX_STS_CALL(tth,crlpnt_crlpnt);
+
         //If they are alredy in contact
         if (s1.contact(s2))
+        {
+            FDX_STS_EVENT(in_contact);
             return 0;//TTH is zero
+        }
 
         else//They are not in contact
         {
@@ -134,7 +506,10 @@ namespace fdx{ namespace arrow
                     //Check that the 2nd degree equation has solution
                     //If the equation has no solution
                     if (disc<0)//Then there is no contact
+                    {
+                        FDX_STS_EVENT(disc_neg);
                         return -1;
+                    }
                     else//Has solution
                     {
                         //Find the two solutions
@@ -149,7 +524,10 @@ namespace fdx{ namespace arrow
                     }
             }
             else//The speed is null, they won't collide
+            {
+                FDX_STS_EVENT(no_speed);
                 return -1;
+            }
         }
     }
 
@@ -197,20 +575,89 @@ namespace fdx{ namespace arrow
         }
     }
 
-    //Time to hit of a rectangle to a circle at the given speed
-    Vct::Mod tth_crlpnt_rct (const Shp& s, const Rct& r, const Vct& speed)
+    /*Time to hit of a circle, not in contact with the rectangle, against the side or corner of the area px,py
+      Negative if the hit is not the first one: the circle must approach the side or corner and be in its area at the hit.
+      The distance to the rectangle is convex along the movement, so a hit while it decreases is the first one*/
+    Vct::Mod hint_crlpnt_rct (const Shp& s, const Rct& r, const Vct& speed, int px, int py)
+    {
+        Vct c(s.get_pos_center()), lo(r.get_pos_corner()), hi(lo+r.get_diagonal());
+        Vct::Mod t;
+
+        //Corner contact
+        if (px&&py)
+        {
+            Vct corner(px>0?hi.x:lo.x,py>0?hi.y:lo.y);
+            t=Crl(c,s.get_size()).tth(Pnt(corner),speed);
+            if (t<0)
+                return -1;
+
+            //Approaching the corner from its area
+            Vct h(c+speed*t), d(h-corner);
+            if (d.x*speed.x+d.y*speed.y>=0||d.x*px<0||d.y*py<0)
+                return -1;
+            return t;
+        }
+
+        //Left or right, the same coordinates as the walk
+        if (px)
+        {
+            if (speed.x*px>=0)
+                return -1;
+            t=px>0?tth_coordinate(c.x-s.get_size(),hi.x,speed.x):tth_coordinate(c.x+s.get_size(),lo.x,speed.x);
+            Vct::Coord y=c.y+speed.y*t;
+            return t>=0&&y>=lo.y&&y<=hi.y?t:-1;
+        }
+
+        //Up or down
+        if (py)
+        {
+            if (speed.y*py>=0)
+                return -1;
+            t=py>0?tth_coordinate(c.y-s.get_size(),hi.y,speed.y):tth_coordinate(c.y+s.get_size(),lo.y,speed.y);
+            Vct::Coord x=c.x+speed.x*t;
+            return t>=0&&x>=lo.x&&x<=hi.x?t:-1;
+        }
+
+        //No area
+        return -1;
+    }
+
+    /*Time to hit of a rectangle to a circle at the given speed
+      px and py get the area of the circle at the hit, or 2 if they were already in contact.
+      If there's a hint its area is checked before walking through the areas*/
+    Vct::Mod walk_crlpnt_rct (const Shp& s, const Rct& r, const Vct& speed, int &px, int &py, const Rgn_hint *hint=nullptr)
     {
+        FDX_STS_CALL(tth,crlpnt_rct);
+
         //If they are alredy in contact, the TTH is 0
         if (s.contact(r))
+        {
+            FDX_STS_EVENT(in_contact);
+            px=py=2;
             return 0;
+        }
 
         //If there's no speed and no contact, there will never be contact
         if (!speed)
+        {
+            FDX_STS_EVENT(no_speed);
             return -1;
+        }
 
-        //Get the initial position of the Crl using the Rct as reference
-        int px,py;//Relative X and Y positions (-1,0,1)
+        //Area of the last hit, if it's still the first hit
+        if (hint&&(hint->px||hint->py))
+        {
+            Vct::Mod t=hint_crlpnt_rct(s,r,speed,hint->px,hint->py);
+            if (t>=0)
+            {
+                FDX_STS_EVENT(hint);
+                px=hint->px;
+                py=hint->py;
+                return t;
+            }
+        }
 
+        //Get the initial position of the Crl using the Rct as reference (relative X and Y positions, -1,0,1)
         rel_pos_crlpnt_rct(s,r,px,py);
 
         //Iterate through the areas to get the next state
@@ -218,12 +665,20 @@ namespace fdx{ namespace arrow
         //Time to hit, time to escape the area and current time
         Vct::Mod tth,tte,t=0;
 
+        //Axes crossed when escaping the area
+        bool escx,escy;
+
         //Make a copy of the circle
         Crl ccopy(s.get_pos_center(),s.get_size());
 
+        //Number of areas visited
+        int regions=0;
+
         //Loop through the areas
         while(true)
         {
+            regions++;
+
             //Detect the area
 
             //Corner contact
@@ -246,6 +701,10 @@ namespace fdx{ namespace arrow
                     tte=std::max(ttex,ttey);
                 else
                     tte=std::min(ttex,ttey);
+
+                //Escape through the side that is reached first (both if at the same time)
+                escx=tte==ttex;
+                escy=tte==ttey;
             }
             //Side contact
             else
@@ -266,6 +725,11 @@ namespace fdx{ namespace arrow
                     }
 
                     tth=tth_coordinate(crl_side,rct_side,speed.x);
+
+                    //Escape up or down
+                    escx=false;
+                    escy=true;
+
                     if (speed.y)
                         tte=speed.y<0?tth_coordinate(ccopy.get_pos_center().y,r.get_pos_corner().y,speed.y):tth_coordinate(ccopy.get_pos_center().y,r.get_pos_corner().y+r.get_diagonal().y,speed.y);
                     else
@@ -288,6 +752,11 @@ namespace fdx{ namespace arrow
                     }
 
                     tth=tth_coordinate(crl_side,rct_side,speed.y);
+
+                    //Escape left or right
+                    escx=true;
+                    escy=false;
+
                     if (speed.x)
                         tte=speed.x<0?tth_coordinate(ccopy.get_pos_center().x,r.get_pos_corner().x,speed.x):tth_coordinate(ccopy.get_pos_center().x,r.get_pos_corner().x+r.get_diagonal().x,speed.x);
                     else
@@ -299,7 +768,10 @@ namespace fdx{ namespace arrow
 
             //No hit, no escape
             if (tth<0&&tte<0)
+            {
+                FDX_STS_LOOP(regions);
                 return -1;
+            }
 
             //Escape
             if (tth<0||(tte<tth&&tte>=0))
@@ -308,81 +780,100 @@ namespace fdx{ namespace arrow
                 t+=tte;
                 ccopy.mov(speed*tte);
 
-                if (speed.x>0&&px<1)px++;
-                else if (speed.x<0&&px>-1)px--;
-                if (speed.y>0&&py<1)py++;
-                else if (speed.y<0&&py>-1)py--;
+                //Only the axes crossed change the area
+                if (escx)
+                {
+                    if (speed.x>0&&px<1)px++;
+                    else if (speed.x<0&&px>-1)px--;
+                }
+                if (escy)
+                {
+                    if (speed.y>0&&py<1)py++;
+                    else if (speed.y<0&&py>-1)py--;
+                }
+
+                //A point escaping a corner through both axes enters the rectangle by the corner, it's a hit in the corner
+                if (!px&&!py)
+                {
+                    FDX_STS_LOOP(regions);
+                    px=speed.x>0?-1:1;
+                    py=speed.y>0?-1:1;
+                    return t;
+                }
             }
 
             //Hit
             else
+            {
+                FDX_STS_LOOP(regions);
                 return tth+t;
+            }
         }
     }
 
-    //(Rct, Rct)
-    //Relative position of the first rectangle to the second
-    //0=center, 1=inside contact, 2=border contact, 3=no contact; sign swaps for other side
-    void rel_pos_rct_rct (const Rct& r1, const Rct& r2, int &px, int &py)
+    //Time to hit of a rectangle to a circle at the given speed
+    Vct::Mod tth_crlpnt_rct (const Shp& s, const Rct& r, const Vct& speed)
     {
-        //Get the data to process
-        Vct d(r2.get_pos_center()-r1.get_pos_center());//Distance between centers
-        Vct s((r1.get_diagonal()+r2.get_diagonal()),0.5);//Size of the rectangles combined
+        int px,py;
+        return walk_crlpnt_rct(s,r,speed,px,py);
+    }
 
-        //Process each side separetly
+    //Time to hit of a rectangle to a circle at the given speed, starting by the area of the hint (updated with the result)
+    Vct::Mod tth_crlpnt_rct (const Shp& s, const Rct& r, const Vct& speed, Rgn_hint &hint)
+    {
+        int px=0,py=0;
+        Vct::Mod t=walk_crlpnt_rct(s,r,speed,px,py,&hint);
 
-        //X
+        //Only hits from outside the rectangle give an area
+        if (t<0||px==2)
+            hint=Rgn_hint();
+        else
+            hint=Rgn_hint{px,py};
+        return t;
+    }
 
-        //Check for centers aligned
-        if (d.x)//Non center
+    //(Rct, Rct)
+    /*Relative position of the first rectangle to the second on an axis at the time t of their contact
+      0=center, 1=inside contact, 2=border contact; sign swaps for other side.
+      Moving axes are borders at the limits of their times of contact, inside between them and centered at the middle.
+      Static axes keep the distance of the sides s1 and s2*/
+    int rel_axis_rct_rct (const Set &tt, Vct::Mod t, Vct::Coord speed, const Set &s1, const Set &s2)
+    {
+        //Distance between centers (from the first to the second) and size of the rectangles combined
+        Vct::Coord d,s=0.5*(s1.get_size()+s2.get_size());
+        int p;
+        if (speed)
         {
-            if (arrow::almost_equal(std::abs(d.x),s.x))//Border contact
-            {
-                px=2;
-            }
-            else//Inside or outside
-            {
-                //Check the type of contact
-                if (std::abs(d.x)<s.x)//Inside
-                    px=1;
-                else//Outside
-                    px=3;
-            }
+            d=speed*(tt.get_middle()-t);
+            if (almost_equal(t,tt.get_min())||almost_equal(t,tt.get_max()))//Border contact
+                p=2;
+            else if (d)//Inside
+                p=1;
+            else//Center
+                p=0;
         }
-        else//Center
-            px=0;
-
-        //Adjust the sign
-        if (d.x<0)px=-px;
-
-        //Y
-
-        //Check for centers aligned
-        if (d.y)//Non center
+        else
         {
-            if (arrow::almost_equal(std::abs(d.y),s.y))//Border contact
-            {
-                py=2;
-            }
-            else//Inside or outside
-            {
-                //Check the type of contact
-                if (std::abs(d.y)<s.y)//Inside
-                    py=1;
-                else//Outside
-                    py=3;
-            }
+            d=s2.get_middle()-s1.get_middle();
+            if (!d)//Center
+                p=0;
+            else if (almost_equal(std::abs(d),s))//Border contact
+                p=2;
+            else//Inside
+                p=1;
         }
-        else//Center
-            py=0;
 
         //Adjust the sign
-        if (d.y<0)py=-py;
+        return d<0?-p:p;
     }
 
-    //Time from the first rectangle to hit the second
-    Vct::Mod tth_rct_rct (const Rct &r1, const Rct &r2, const Vct& speed)
+    /*Time from the first rectangle to hit the second, -1 if there's no contact ahead
+      Not limited to the tick, like the rest of the shapes (hits after it give times above 1)
+      ttx and tty get the times of contact of each axis*/
+    Vct::Mod walk_rct_rct (const Rct &r1, const Rct &r2, const Vct& speed, Set &ttx, Set &tty)
     {
+        FDX_STS_CALL(tth,rct_rct);
+
         //Sides
 
         //R1
@@ -394,41 +885,679 @@ namespace fdx{ namespace arrow
         Set r2y(r2.get_pos_corner().y,r2.get_pos_corner().y+r2.get_diagonal().y);//Y
 
         //Time of contact
-        Set ttc(Set::min_intersect(r1x.tth(r2x,speed.x),r1y.tth(r2y,speed.y)));//Intersection between X and Y TTCs
+        ttx=tth_set_set(r1x,r2x,speed.x);
+        tty=tth_set_set(r1y,r2y,speed.y);
+        Set ttc(Set::min_intersect(ttx,tty));//Intersection between X and Y TTCs
 
         //Check for contact at the begining
         if (ttc.check_value(0))//If 0 is on the set, the contact starts at the begining
+        {
+            FDX_STS_EVENT(in_contact);
             return 0;
-        else//If 0 is not on the set, return the tth (start of ttc) if it's at the left, or 1 if it's at the right
-            return ttc.get_min()<0?1:std::min(1.0,ttc.get_min());
+        }
+        else//If 0 is not on the set, return the tth (start of ttc) if it's in the future, or -1 if there's no contact ahead
+            return (!ttc.valid()||ttc.get_min()<0)?-1:ttc.get_min();
     }
 
-    /*Move against a shape*/
+    //Time from the first rectangle to hit the second
+    Vct::Mod tth_rct_rct (const Rct &r1, const Rct &r2, const Vct& speed)
+    {
+        Set ttx,tty;
+        return walk_rct_rct(r1,r2,speed,ttx,tty);
+    }
 
-    //Move the first shape against the other at the given speed
+    //(Crl/Pnt, Obb)
 
-    //(Crl, Pnt)
-    Vct mov_against_crlpnt_crlpnt (const Shp& s1, const Shp& s2, const Vct& speed)
+    //Time for a circle/point to hit an oriented rectangle (as a rectangle in its own frame)
+    Vct::Mod tth_crlpnt_obb (const Shp& s, const Obb& o, const Vct& speed)
     {
-        //Get the time to hit
-        Vct::Mod t=tth_crlpnt_crlpnt(s1,s2,speed);
+        return tth_crlpnt_rct(local_crlpnt_obb(s,o),local_obb(o),to_local_obb(o,speed));
+    }
 
-        //Check if the speed needs to be restricted
-        //If it will hit in this tick
-        if ((t>=0)&&(t<1))//Restrict the speed
+    //(Obb, Obb)
+
+    /*Time from the first oriented rectangle to hit the second
+      p gets the projections and the times of contact on each separating axis*/
+    Vct::Mod walk_obb_obb (const Obb &o1, const Obb &o2, const Vct& speed, Sat_obb &p)
+    {
+        FDX_STS_CALL(tth,obb_obb);
+
+        sat_obb_obb(o1,o2,speed,p);
+
+        //Times of contact of each axis (the size of both is on the first set), the contact is their intersection
+        Set ttc(-std::numeric_limits<Set::Limit>::infinity(),std::numeric_limits<Set::Limit>::infinity());
+        for (int i=0;i<4;i++)
         {
-            //Get the distance
-            Vct d(s2.get_pos_center()-s1.get_pos_center());
+            p.tt[i]=tth_set_set(Set(p.c[i]-p.r[i],p.c[i]+p.r[i]),Set(0,0),p.v[i]);
+            ttc=Set::min_intersect(ttc,p.tt[i]);
+        }
 
-            //Check if centers match
-            if (d)//Centers don't match
+        //Check for contact at the begining
+        if (ttc.check_value(0))
+        {
+            FDX_STS_EVENT(in_contact);
+            return 0;
+        }
+        else
+            return (!ttc.valid()||ttc.get_min()<0)?-1:ttc.get_min();
+    }
+
+    //Time from the first oriented rectangle to hit the second
+    Vct::Mod tth_obb_obb (const Obb &o1, const Obb &o2, const Vct& speed)
+    {
+        Sat_obb p;
+        return walk_obb_obb(o1,o2,speed,p);
+    }
+
+    //(Crl/Pnt, Pol)
+
+    /*Time for a ray from q to hit a polygon rounded by rr (sides moved out by rr and a circle on every vertex)
+      side gets the side hit, end if it was its first vertex; the ray must start outside*/
+    Vct::Mod ray_pol (const Pol_view &p, const Vct &q, const Vct &speed, Vct::Mod rr, std::size_t &side, bool &end)
+    {
+        Vct::Mod best=-1;
+        const Vct::Coord *x=p.x, *y=p.y, *nx=p.nx, *ny=p.ny;
+        std::size_t n=p.n;
+
+        for (std::size_t i=0;i<n;i++)
+        {
+            //Side moved out by the radius, only if the ray goes towards it
+            Vct::Coord dn=speed.x*nx[i]+speed.y*ny[i];
+            if (dn<0)
             {
-                //Check if the shapes were in contact
-                if (t==0)//Shapes are in contact, restrict the tangencial part of the speed if needed
+                Vct::Mod t=(rr-((q.x-x[i])*nx[i]+(q.y-y[i])*ny[i]))/dn;
+                if (t>=0&&(best<0||t<best))
                 {
-                    //Check if the part of the speed that is tangencial to the distance goes in the same direction
-                    //If is the same direction
-                    if (speed.mod_tan_part(d)>0)//Restrict the movement
+                    //The hit must be between the ends of the side
+                    std::size_t j=i+1<n?i+1:0;
+                    Vct e(x[j]-x[i],y[j]-y[i]);
+                    Vct::Mod k=dot(q+speed*t-Vct(x[i],y[i]),e);
+                    if (k>=0&&k<=e.sq_mod())
+                    {
+                        best=t;
+                        side=i;
+                        end=false;
+                    }
+                }
+            }
+
+            //Rounded vertex
+            if (rr>0)
+            {
+                Vct f(q.x-x[i],q.y-y[i]);
+                double
+                    ac=speed.sq_mod(),
+                    bc=2*dot(f,speed),
+                    cc=f.sq_mod()-rr*rr;
+                double disc=bc*bc-4*ac*cc;
+                if (disc>=0)
+                {
+                    Vct::Mod t=(-bc-std::sqrt(disc))/(2*ac);
+                    if (t>=0&&(best<0||t<best))
+                    {
+                        best=t;
+                        side=i;
+                        end=true;
+                    }
+                }
+            }
+        }
+        return best;
+    }
+
+
+    /*Time for a circle/point to hit a polygon, as a ray against the polygon rounded by the radius
+      side gets the side hit, end if it was its first vertex (not set if they were already in contact)*/
+    Vct::Mod walk_crlpnt_pol (const Shp& s, const Pol& p, const Vct& speed, std::size_t &side, bool &end)
+    {
+        FDX_STS_CALL(tth,crlpnt_pol);
+
+        //If they are alredy in contact, the TTH is 0
+        if (s.contact(p))
+        {
+            FDX_STS_EVENT(in_contact);
+            return 0;
+        }
+
+        //If there's no speed and no contact, there will never be contact
+        if (!speed)
+        {
+            FDX_STS_EVENT(no_speed);
+            return -1;
+        }
+
+        //Ray from the center, relative to the polygon
+        return ray_pol(view_pol(p),s.get_pos_center()-p.get_pos_center(),speed,s.get_size(),side,end);
+    }
+
+    //Time for a circle/point to hit a polygon
+    Vct::Mod tth_crlpnt_pol (const Shp& s, const Pol& p, const Vct& speed)
+    {
+        std::size_t side;
+        bool end;
+        return walk_crlpnt_pol(s,p,speed,side,end);
+    }
+
+    //(Pol, Pol)
+
+    //Axis of the contact between two polygons
+    struct Sat_pol
+    {
+        Vct axis;//Normal of the side that owns the axis
+        Vct axis2;//Axis that starts its contact at the same time (not parallel), for corner contacts
+        std::size_t side;//Side that owns the axis
+        bool own;//The side is of the first polygon
+        bool corner;//There is a second axis
+    };
+
+    /*Time from the first polygon to hit the second
+      res gets the last axis to start its contact, or the one with less penetration if they were in contact*/
+    Vct::Mod walk_pol_pol (const Pol &p1, const Pol &p2, const Vct& speed, Sat_pol &res)
+    {
+        FDX_STS_CALL(tth,pol_pol);
+
+        if (!p1.get_count()||!p2.get_count())
+            return -1;
+
+        //Intersection of the times of contact of every axis
+        Set ttc(-std::numeric_limits<Set::Limit>::infinity(),std::numeric_limits<Set::Limit>::infinity());
+        Sat_pol pen{};
+        Vct::Mod entry=0, depth=0;
+        bool found=false;
+
+        for (int k=0;k<2;k++)
+        {
+            const Pol &p=k?p2:p1;
+            for (std::size_t i=0;i<p.get_count();i++)
+            {
+                Vct a(p.get_normal(i));
+                Set s1(proj_pol(p1,a)), s2(proj_pol(p2,a));
+                Set tt(tth_set_set(s1,s2,dot(speed,a)));
+                ttc=Set::min_intersect(ttc,tt);
+
+                //Separated on this axis for ever
+                if (!ttc.valid())
+                    return -1;
+
+                //Last axis to start its contact
+                bool tie=found&&almost_equal(tt.get_min(),entry);
+                if (!found||(tt.get_min()>entry&&!tie))
+                {
+                    res=Sat_pol{a,Vct(),i,k==0,false};
+                    entry=tt.get_min();
+                }
+                else if (tie&&!res.corner&&std::isfinite(entry)&&std::abs(cross(a,res.axis))>EPSILON_COMP)
+                {
+                    res.axis2=a;
+                    res.corner=true;
+                }
+
+                //Axis with less penetration
+                Vct::Mod d=std::min(s1.get_max()-s2.get_min(),s2.get_max()-s1.get_min());
+                if (!found||d<depth)
+                {
+                    pen=Sat_pol{a,Vct(),i,k==0,false};
+                    depth=d;
+                }
+                found=true;
+            }
+        }
+
+        //Check for contact at the begining
+        if (ttc.check_value(0))
+        {
+            FDX_STS_EVENT(in_contact);
+            res=pen;
+            return 0;
+        }
+        else
+            return ttc.get_min()<0?-1:ttc.get_min();
+    }
+
+    //Time from the first polygon to hit the second
+    Vct::Mod tth_pol_pol (const Pol &p1, const Pol &p2, const Vct& speed)
+    {
+        Sat_pol res;
+        return walk_pol_pol(p1,p2,speed,res);
+    }
+
+    //(Cap, Shp)
+
+    /*Time from the first shape to hit the second, as a ray from the origin against their Minkowski difference
+      m gets the difference, side the side hit and end if it was its first vertex (not set if they were already in contact)*/
+    Vct::Mod walk_cap (const Shp &s1, const Shp &s2, const Vct& speed, const Mink* &m, std::size_t &side, bool &end)
+    {
+        FDX_STS_CALL(tth,cap_shp);
+
+        m=&mink_shp(s1,s2);
+
+        //If they are alredy in contact, the TTH is 0
+        if (contact_mink(*m))
+        {
+            FDX_STS_EVENT(in_contact);
+            return 0;
+        }
+
+        //If there's no speed and no contact, there will never be contact
+        if (!speed)
+        {
+            FDX_STS_EVENT(no_speed);
+            return -1;
+        }
+
+        return ray_pol(view_mink(*m),Vct(),speed,m->ra+m->rb,side,end);
+    }
+
+    //Time from the first shape to hit the second, one of them a capsule
+    Vct::Mod tth_cap (const Shp &s1, const Shp &s2, const Vct& speed)
+    {
+        const Mink *m;
+        std::size_t side;
+        bool end;
+        return walk_cap(s1,s2,speed,m,side,end);
+    }
+
+    /*TOI*/
+
+    //Time of impact from the first shape to the second at the given speed, with the contact data
+
+    //No impact
+    Toi no_toi ()
+    {
+        return Toi{-1,Vct(),Vct(),Toi::Feature::none};
+    }
+
+    //Impact seen from the second shape, moving at the given speed against the first one
+    Toi flip_toi (const Toi &toi, const Vct &speed)
+    {
+        if (toi.t<0)
+            return toi;
+        return Toi{toi.t,-toi.normal,toi.point+speed*toi.t,toi.feature};
+    }
+
+    //Unitary normal, or against the speed if it's null
+    Vct unit_normal (const Vct &n, const Vct &speed)
+    {
+        Vct u(n?n:-speed);
+        u.unitary();
+        return u;
+    }
+
+    //(Crl/Pnt, Crl/Pnt)
+    Toi toi_crlpnt_crlpnt (const Shp& s1, const Shp& s2, const Vct& speed)
+    {
+        Vct::Mod t=tth_crlpnt_crlpnt(s1,s2,speed);
+        if (t<0)
+            return no_toi();
+
+        //Normal between the centers at the hit
+        Vct n(unit_normal(s1.get_pos_center()+speed*t-s2.get_pos_center(),speed));
+        return Toi{t,n,s2.get_pos_center()+n*s2.get_size(),Toi::Feature::round};
+    }
+
+    //(Crl/Pnt, Rct)
+    Toi toi_crlpnt_rct (const Shp& s, const Rct& r, const Vct& speed)
+    {
+        //Time and area of the hit
+        int px,py;
+        Vct::Mod t=walk_crlpnt_rct(s,r,speed,px,py);
+        if (t<0)
+            return no_toi();
+
+        //Already in contact, the area is the current one
+        if (px==2)
+            rel_pos_crlpnt_rct(s,r,px,py);
+
+        //Center of the circle at the hit
+        Vct c(s.get_pos_center()+speed*t);
+        Vct corner(r.get_pos_corner()), diagonal(r.get_diagonal());
+
+        //Corner contact
+        if (px&&py)
+        {
+            if (px>0)corner.x+=diagonal.x;
+            if (py>0)corner.y+=diagonal.y;
+            return Toi{t,unit_normal(c-corner,speed),corner,Toi::Feature::corner};
+        }
+
+        //Center of circle inside rectangle
+        if (!(px||py))
+            return Toi{t,unit_normal(c-r.get_pos_center(),speed),c,Toi::Feature::center};
+
+        //Side contact
+        Vct p(Box(corner,diagonal).closest(c));
+        if (px)//X side
+        {
+            p.x=px<0?corner.x:corner.x+diagonal.x;
+            return Toi{t,Vct(px,0),p,Toi::Feature::side};
+        }
+        else//Y side
+        {
+            p.y=py<0?corner.y:corner.y+diagonal.y;
+            return Toi{t,Vct(0,py),p,Toi::Feature::side};
+        }
+    }
+
+    //(Rct, Rct)
+    Toi toi_rct_rct (const Rct &r1, const Rct &r2, const Vct& speed)
+    {
+        //Time of the hit and times of contact of each axis
+        Set ttx,tty;
+        Vct::Mod t=walk_rct_rct(r1,r2,speed,ttx,tty);
+        if (t<0)
+            return no_toi();
+
+        /*Get the relative position of each axis at the hit from its times of contact
+          Axes that touch at the hit are borders (corner grazes and sliding along a side included)*/
+        Box b1(r1), b2(r2);
+        int px=rel_axis_rct_rct(ttx,t,speed.x,b1.x,b2.x), py=rel_axis_rct_rct(tty,t,speed.y,b1.y,b2.y);
+
+        //Sides of the first rectangle at the hit
+        b1.x=Set(b1.x.get_min()+speed.x*t,b1.x.get_max()+speed.x*t);
+        b1.y=Set(b1.y.get_min()+speed.y*t,b1.y.get_max()+speed.y*t);
+        Vct::Coord
+            sx=px>0?b2.x.get_min():b2.x.get_max(),
+            sy=py>0?b2.y.get_min():b2.y.get_max();
+
+        //Corner contact
+        if (std::abs(px)>=2&&std::abs(py)>=2)
+            return Toi{t,unit_normal(Vct(-px,-py),speed),Vct(sx,sy),Toi::Feature::corner};
+
+        //Border contact on left/right
+        if (std::abs(px)>=2)
+            return Toi{t,Vct(px>0?-1:1,0),Vct(sx,Set::min_intersect(b1.y,b2.y).get_middle()),Toi::Feature::side};
+
+        //Border contact on top/bottom
+        if (std::abs(py)>=2)
+            return Toi{t,Vct(0,py>0?-1:1),Vct(Set::min_intersect(b1.x,b2.x).get_middle(),sy),Toi::Feature::side};
+
+        //Inside contact, the signs of the normal give the directions to limit
+        return Toi{t,unit_normal(Vct(-px,-py),speed),r1.get_pos_center()+speed*t,Toi::Feature::center};
+    }
+
+    //(Crl/Pnt, Obb)
+    Toi toi_crlpnt_obb (const Shp& s, const Obb& o, const Vct& speed)
+    {
+        //Impact in the frame of the rectangle
+        Toi toi=toi_crlpnt_rct(local_crlpnt_obb(s,o),local_obb(o),to_local_obb(o,speed));
+
+        //Back to the world frame
+        if (toi.t>=0)
+        {
+            toi.normal=to_world_obb(o,toi.normal);
+            toi.point=o.get_pos_center()+to_world_obb(o,toi.point);
+        }
+        return toi;
+    }
+
+    //(Obb, Obb)
+    Toi toi_obb_obb (const Obb &o1, const Obb &o2, const Vct& speed)
+    {
+        //Time of the hit and projections on the separating axes
+        Sat_obb p;
+        Vct::Mod t=walk_obb_obb(o1,o2,speed,p);
+        if (t<0)
+            return no_toi();
+
+        //Axis of the contact: the last one to start its contact, or the one with less penetration if they were in contact
+        int k=0;
+        for (int i=1;i<4;i++)
+        {
+            if (t>0)
+            {
+                if (p.tt[i].get_min()>p.tt[k].get_min())
+                    k=i;
+            }
+            else if (p.r[i]-std::abs(p.c[i])<p.r[k]-std::abs(p.c[k]))
+                k=i;
+        }
+
+        //Normal from the second rectangle to the first
+        Vct::Coord ck=p.c[k]+p.v[k]*t;
+        Vct n(p.ax[k],p.ay[k]);
+        if (ck<0||(!ck&&p.v[k]>0))
+            n.inv_dir();
+
+        //Corner contact, another axis (not parallel) starts its contact at the same time
+        Toi::Feature feature=Toi::Feature::side;
+        for (int i=0;i<4&&t>0;i++)
+        {
+            if (i!=k&&std::abs(cross(Vct(p.ax[i],p.ay[i]),Vct(p.ax[k],p.ay[k])))>EPSILON_COMP&&almost_equal(p.tt[i].get_min(),p.tt[k].get_min()))
+            {
+                Vct ni(p.ax[i],p.ay[i]);
+                if (p.c[i]+p.v[i]*t<0)
+                    ni.inv_dir();
+                n=unit_normal(n+ni,speed);
+                feature=Toi::Feature::corner;
+                break;
+            }
+        }
+
+        //Copy of the first rectangle at the hit
+        Obb ocopy(o1);
+        ocopy.mov(speed*t);
+
+        //Reference rectangle (owns the axis of the contact) and incident rectangle (its vertices touch the reference)
+        bool own=k<2;
+        const Obb &ref=own?ocopy:o2, &inc=own?o2:ocopy;
+        Vct dir(own?n:-n);//Direction of the incident vertices towards the reference
+
+        //Vertices of the incident rectangle that go furthest towards the reference
+        Vct iu(inc.get_axis_x(),0.5*inc.get_side().x), iv(inc.get_axis_y(),0.5*inc.get_side().y);
+        Vct vert[4]={inc.get_pos_center()+iu+iv,inc.get_pos_center()+iu-iv,inc.get_pos_center()-iu-iv,inc.get_pos_center()-iu+iv};
+        Vct::Coord tol=EPSILON_COMP*(inc.get_side().x+inc.get_side().y);
+        int best=0,tied=-1;
+        for (int i=1;i<4;i++)
+            if (dot(vert[i],dir)>dot(vert[best],dir))
+                best=i;
+        for (int i=0;i<4;i++)
+            if (i!=best&&dot(vert[best],dir)-dot(vert[i],dir)<=tol)
+                tied=i;
+
+        //Single vertex, it's the point of contact
+        if (tied<0)
+            return Toi{t,n,vert[best],feature};
+
+        //Side against side, the point is the middle of the part of the incident side that faces the reference side
+        Vct tg(-n.y,n.x);
+        Vct::Coord a=dot(vert[best],tg), b=dot(vert[tied],tg);
+        Vct::Coord rc=dot(ref.get_pos_center(),tg);
+        Vct::Coord re=0.5*ref.get_side().x*std::abs(dot(ref.get_axis_x(),tg))+0.5*ref.get_side().y*std::abs(dot(ref.get_axis_y(),tg));
+        Set face(Set::min_intersect(Set(std::min(a,b),std::max(a,b)),Set(rc-re,rc+re)));
+        Vct::Coord m=face.valid()?face.get_middle():(a+b)/2;
+        return Toi{t,n,vert[best]+tg*(m-a),feature};
+    }
+
+    //(Crl/Pnt, Pol)
+    Toi toi_crlpnt_pol (const Shp& s, const Pol& p, const Vct& speed)
+    {
+        //Time and feature of the hit
+        std::size_t side;
+        bool end;
+        Vct::Mod t=walk_crlpnt_pol(s,p,speed,side,end);
+        if (t<0)
+            return no_toi();
+
+        //Center of the circle at the hit, relative to the polygon
+        Vct q(s.get_pos_center()+speed*t-p.get_pos_center());
+
+        //Already in contact, the feature is the current one
+        if (t==0)
+        {
+            //Center of the circle inside the polygon
+            if (inside_pol(view_pol(p),q,side))
+                return Toi{t,p.get_normal(side),s.get_pos_center(),Toi::Feature::center};
+
+            Vct c;
+            closest_pol(view_pol(p),q,side,end,c);
+        }
+
+        //Vertex contact
+        if (end)
+        {
+            Vct v(p.vertex_x()[side],p.vertex_y()[side]);
+            return Toi{t,unit_normal(q-v,speed),p.get_pos_center()+v,Toi::Feature::corner};
+        }
+
+        //Side contact
+        Vct n(p.get_normal(side));
+        Vct::Mod k=dot(q,n)-dot(Vct(p.vertex_x()[side],p.vertex_y()[side]),n);//Distance from the center to the side
+        return Toi{t,n,p.get_pos_center()+q-n*k,Toi::Feature::side};
+    }
+
+    //(Pol, Pol)
+    Toi toi_pol_pol (const Pol &p1, const Pol &p2, const Vct& speed)
+    {
+        //Time of the hit and axis of the contact
+        Sat_pol res;
+        Vct::Mod t=walk_pol_pol(p1,p2,speed,res);
+        if (t<0)
+            return no_toi();
+
+        //Movement of the first polygon until the hit
+        Vct off(speed*t);
+
+        //Normal from the second polygon to the first, looking at the middle of both projections at the hit
+        Set s1(proj_pol(p1,res.axis)), s2(proj_pol(p2,res.axis));
+        Vct n(s1.get_middle()+dot(off,res.axis)>=s2.get_middle()?res.axis:-res.axis);
+
+        //Corner contact, the normal goes between both axes
+        Toi::Feature feature=Toi::Feature::side;
+        if (res.corner)
+        {
+            s1=proj_pol(p1,res.axis2);
+            s2=proj_pol(p2,res.axis2);
+            n=unit_normal(n+(s1.get_middle()+dot(off,res.axis2)>=s2.get_middle()?res.axis2:-res.axis2),speed);
+            feature=Toi::Feature::corner;
+        }
+
+        //Reference polygon (owns the side of the contact) and incident polygon (its vertices touch the reference)
+        const Pol &ref=res.own?p1:p2, &inc=res.own?p2:p1;
+        Vct ref_c(ref.get_pos_center()+(res.own?off:Vct())), inc_c(inc.get_pos_center()+(res.own?Vct():off));
+        Vct dir(res.own?n:-n);//Direction of the incident vertices towards the reference
+
+        //Vertices of the incident polygon that go furthest towards the reference
+        const Vct::Coord *x=inc.vertex_x(), *y=inc.vertex_y();
+        std::size_t m=inc.get_count(), best=0;
+        for (std::size_t i=1;i<m;i++)
+            if (x[i]*dir.x+y[i]*dir.y>x[best]*dir.x+y[best]*dir.y)
+                best=i;
+        Vct::Coord top=x[best]*dir.x+y[best]*dir.y, tol=EPSILON_COMP*2*inc.get_size();
+        std::size_t next=best+1<m?best+1:0, prev=best?best-1:m-1, tied=m;
+        if (top-(x[next]*dir.x+y[next]*dir.y)<=tol)
+            tied=next;
+        else if (top-(x[prev]*dir.x+y[prev]*dir.y)<=tol)
+            tied=prev;
+
+        Vct vb(inc_c+Vct(x[best],y[best]));
+
+        //Single vertex, it's the point of contact
+        if (tied==m||m<2)
+            return Toi{t,n,vb,feature};
+
+        //Side against side, the point is the middle of the part of the incident side that faces the reference side
+        Vct tg(-n.y,n.x);
+        Vct vt(inc_c+Vct(x[tied],y[tied]));
+        std::size_t rs=res.side, rn=rs+1<ref.get_count()?rs+1:0;
+        Vct::Coord
+            a=dot(vb,tg), b=dot(vt,tg),
+            ra=dot(ref_c+Vct(ref.vertex_x()[rs],ref.vertex_y()[rs]),tg),
+            rb=dot(ref_c+Vct(ref.vertex_x()[rn],ref.vertex_y()[rn]),tg);
+        Set face(Set::min_intersect(Set(std::min(a,b),std::max(a,b)),Set(std::min(ra,rb),std::max(ra,rb))));
+        Vct::Coord mid=face.valid()?face.get_middle():(a+b)/2;
+        return Toi{t,n,vb+tg*(mid-a),feature};
+    }
+
+    //(Cap, Shp)
+    Toi toi_cap (const Shp &s1, const Shp &s2, const Vct& speed)
+    {
+        //Time and feature of the hit
+        const Mink *m;
+        std::size_t side;
+        bool end;
+        Vct::Mod t=walk_cap(s1,s2,speed,m,side,end);
+        if (t<0)
+            return no_toi();
+
+        //Position of the origin at the hit
+        Pol_view v(view_mink(*m));
+        Vct q(speed*t);
+        Toi::Feature feature=Toi::Feature::side;
+
+        //Already in contact, the feature is the current one
+        if (t==0)
+        {
+            Vct c;
+            if (inside_pol(v,q,side))
+            {
+                end=false;
+                feature=Toi::Feature::center;
+            }
+            else
+                closest_pol(v,q,side,end,c);
+        }
+
+        //Vertex of the difference, a point of the second shape against the first one
+        if (end)
+        {
+            Vct n(unit_normal(q-Vct(v.x[side],v.y[side]),speed));
+            return Toi{t,n,m->b[m->ib[side]]+n*m->rb,m->rb>0?Toi::Feature::round:Toi::Feature::corner};
+        }
+
+        //Side of the difference, the point of the second shape is at the same place of its side
+        std::size_t next=side+1<v.n?side+1:0;
+        Vct n(v.nx[side],v.ny[side]), e(v.x[next]-v.x[side],v.y[next]-v.y[side]);
+        Vct::Mod k=e?dot(q-Vct(v.x[side],v.y[side]),e)/e.sq_mod():0;
+        k=std::max(Vct::Mod(0),std::min(Vct::Mod(1),k));
+        Vct b(m->b[m->ib[side]]+(m->b[m->ib[next]]-m->b[m->ib[side]])*k);
+        return Toi{t,n,b+n*m->rb,feature};
+    }
+
+    /*Move against a shape*/
+
+    //Move the first shape against the other at the given speed
+
+    //Movement limited by a TOI in this tick: free until the hit, then the part of the speed against the normal is removed (slides)
+    Vct slide_toi (const Vct &speed, const Toi &toi)
+    {
+        //Speed not limited by the toi
+        Vct speed_free(speed,toi.t);
+
+        //Remove the part of the remaining speed that goes against the normal
+        Vct speed_left(speed-speed_free);
+        Vct::Coord towards=dot(speed_left,toi.normal);
+        if (towards<0)
+            speed_left-=toi.normal*towards;
+
+        return speed_free+speed_left;
+    }
+
+    //(Crl, Pnt)
+    Vct mov_against_crlpnt_crlpnt (const Shp& s1, const Shp& s2, const Vct& speed)
+    {
+        FDX_STS_CALL(mov_against,crlpnt_crlpnt);
+
+        //Get the time to hit
+        Vct::Mod t=tth_crlpnt_crlpnt(s1,s2,speed);
+
+        //Check if the speed needs to be restricted
+        //If it will hit in this tick
+        if ((t>=0)&&(t<1))//Restrict the speed
+        {
+            FDX_STS_EVENT(clamp);
+
+            //Get the distance
+            Vct d(s2.get_pos_center()-s1.get_pos_center());
+
+            //Check if centers match
+            if (d)//Centers don't match
+            {
+                //Check if the shapes were in contact
+                if (t==0)//Shapes are in contact, restrict the tangencial part of the speed if needed
+                {
+                    //Check if the part of the speed that is tangencial to the distance goes in the same direction
+                    //If is the same direction
+                    if (speed.mod_tan_part(d)>0)//Restrict the movement
                         return speed.nor_part(d);//The tangencial part is restricted and only the normal part remains
                     else//If the direction is the opposite, the speed remains untouched
                         return speed;
@@ -445,405 +1574,1481 @@ namespace fdx{ namespace arrow
             return speed;
     }
 
-    //(Crl/Pnt, Rct)
-    Vct mov_against_crlpnt_rct (const Shp& s, const Rct& r, const Vct& speed)
+    //(Crl/Pnt, Rct)
+    Vct mov_against_crlpnt_rct (const Shp& s, const Rct& r, const Vct& speed)
+    {
+        FDX_STS_CALL(mov_against,crlpnt_rct);
+
+        //Get the toi from this circle to the rectangle
+        Toi toi=toi_crlpnt_rct(s,r,speed);
+
+        //Check if the TOI limits the movement
+        if (toi.t>=1||toi.t<0)//No limit
+            return speed;
+
+        FDX_STS_EVENT(clamp);
+
+        //Speed is limited, process it
+        Vct speed_free(speed,toi.t);//Speed not limited by the toi
+
+        //Process the remaining speed
+        Vct speed_left(speed-speed_free);
+
+        //Check the type of contact
+        switch (toi.feature)
+        {
+            case Toi::Feature::corner://Move the circle against the corner
+            {
+                Crl ccopy(s.get_pos_center()+speed_free,s.get_size());//Copy of the circle
+                speed_left=ccopy.mov_against(Pnt(toi.point),speed_left);
+                break;
+            }
+
+            case Toi::Feature::center://Center of circle inside rectangle, move against the rectangle's center
+            {
+                Crl ccopy(s.get_pos_center()+speed_free,s.get_size());//Copy of the circle
+                speed_left=ccopy.mov_against(Crl(r.get_pos_center(),r.get_size()),speed_left);
+                break;
+            }
+
+            default://Side contact, restrict the movement towards the side
+            {
+                if (toi.normal.x)//X side
+                {
+                    if (speed_left.x*toi.normal.x<0)speed_left.x=0;
+                }
+                else//Y side
+                {
+                    if (speed_left.y*toi.normal.y<0)speed_left.y=0;
+                }
+                break;
+            }
+        }
+
+        //Return the not limited movement and the limited movement
+        return speed_free+speed_left;
+    }
+
+
+    //(Rct, Rct)
+    Vct mov_against_rct_rct (const Rct& r1, const Rct& r2, const Vct& speed)
+    {
+        FDX_STS_CALL(mov_against,rct_rct);
+
+        //Get the toi from the first rectangle to the second
+        Toi toi=toi_rct_rct(r1,r2,speed);
+
+        //Check if the TOI limits the movement
+        if (toi.t>=1||toi.t<0)//No limit
+            return speed;
+
+        FDX_STS_EVENT(clamp);
+
+        //Speed is limited, process it
+        Vct speed_free(speed,toi.t);//Speed not limited by the toi
+
+        //Process the remaining speed
+        Vct speed_left(speed-speed_free);
+
+        //Check the type of contact (the speed goes towards the second rectangle if it's against the normal)
+        switch (toi.feature)
+        {
+            case Toi::Feature::corner:
+            {
+                //Check if the speed goes on the same direction as the corner (inside the Rct)
+                if (speed_left.x*toi.normal.x<0&&speed_left.y*toi.normal.y<0)//Only one component of the speed is to be kept (priority on X)
+                {
+                    if (std::abs(speed_left.x)>=std::abs(speed_left.y))
+                        speed_left.y=0;//X is kept
+                    else
+                        speed_left.x=0;//Y is kept
+                }
+                //Else, the speed does not need to be modified
+                break;
+            }
+
+            case Toi::Feature::side:
+            {
+                if (toi.normal.x)//Border contact on left/right
+                {
+                    if (speed_left.x*toi.normal.x<0)//If the speed goes towards the center, limit it
+                        speed_left.x=0;
+                }
+                else//Border contact on top bottom
+                {
+                    if (speed_left.y*toi.normal.y<0)//If the speed goes towards the center, limit it
+                        speed_left.y=0;
+                }
+                break;
+            }
+
+            default://Inside contact, the axes in which the speed goes towards the center of the second rectangle are limited
+            {
+                Vct d(r2.get_pos_center()-r1.get_pos_center()-speed_free);//No limit if the centers are the same
+                if (speed_left.x*d.x>0)//X limit
+                    speed_left.x=0;
+                if (speed_left.y*d.y>0)//Y limit
+                    speed_left.y=0;
+                break;
+            }
+        }
+
+        //Return the speed
+        return speed_free+speed_left;
+    }
+
+    //(Crl/Pnt, Obb)
+    Vct mov_against_crlpnt_obb (const Shp& s, const Obb& o, const Vct& speed)
+    {
+        //Movement in the frame of the rectangle
+        Vct lspeed(to_local_obb(o,speed));
+        Vct lmov(mov_against_crlpnt_rct(local_crlpnt_obb(s,o),local_obb(o),lspeed));
+
+        //Back to the world frame (if not limited, the speed is returned as it was)
+        return lmov==lspeed?speed:to_world_obb(o,lmov);
+    }
+
+    //(Obb, Obb)
+    Vct mov_against_obb_obb (const Obb& o1, const Obb& o2, const Vct& speed)
+    {
+        FDX_STS_CALL(mov_against,obb_obb);
+
+        //Get the toi from the first rectangle to the second
+        Toi toi=toi_obb_obb(o1,o2,speed);
+
+        //Check if the TOI limits the movement
+        if (toi.t>=1||toi.t<0)//No limit
+            return speed;
+
+        FDX_STS_EVENT(clamp);
+
+        //The rectangle slides along the side
+        return slide_toi(speed,toi);
+    }
+
+    //(Crl/Pnt, Pol)
+    Vct mov_against_crlpnt_pol (const Shp& s, const Pol& p, const Vct& speed)
+    {
+        FDX_STS_CALL(mov_against,crlpnt_pol);
+
+        //Get the toi from the circle to the polygon
+        Toi toi=toi_crlpnt_pol(s,p,speed);
+
+        //Check if the TOI limits the movement
+        if (toi.t>=1||toi.t<0)//No limit
+            return speed;
+
+        FDX_STS_EVENT(clamp);
+
+        //Vertex contact, move the circle against the vertex
+        if (toi.feature==Toi::Feature::corner)
+        {
+            Vct speed_free(speed,toi.t);
+            Crl ccopy(s.get_pos_center()+speed_free,s.get_size());
+            return speed_free+ccopy.mov_against(Pnt(toi.point),speed-speed_free);
+        }
+
+        //Side contact, slide along it
+        return slide_toi(speed,toi);
+    }
+
+    //(Pol, Pol)
+    Vct mov_against_pol_pol (const Pol& p1, const Pol& p2, const Vct& speed)
+    {
+        FDX_STS_CALL(mov_against,pol_pol);
+
+        //Get the toi from the first polygon to the second
+        Toi toi=toi_pol_pol(p1,p2,speed);
+
+        //Check if the TOI limits the movement
+        if (toi.t>=1||toi.t<0)//No limit
+            return speed;
+
+        FDX_STS_EVENT(clamp);
+        return slide_toi(speed,toi);
+    }
+
+    //(Cap, Shp)
+    Vct mov_against_cap (const Shp& s1, const Shp& s2, const Vct& speed)
+    {
+        FDX_STS_CALL(mov_against,cap_shp);
+
+        //Get the toi from the first shape to the second
+        Toi toi=toi_cap(s1,s2,speed);
+
+        //Check if the TOI limits the movement
+        if (toi.t>=1||toi.t<0)//No limit
+            return speed;
+
+        FDX_STS_EVENT(clamp);
+        return slide_toi(speed,toi);
+    }
+
+    /* Crl */
+
+    /*Contact*/
+
+    //Contact with a generic shape
+    bool Crl::contact (const Shp &s) const
+    {
+        return s.contact(*this);
+    }
+
+    //Contact with a circle
+    bool Crl::contact (const Crl &c) const
+    {
+        return arrow::contact_crlpnt_crlpnt(*this,c);
+    }
+
+    //Contact with a point
+    bool Crl::contact (const Pnt &p) const
+    {
+        return arrow::contact_crlpnt_crlpnt(*this,p);
+    }
+
+    //Contact with a rectangle
+    bool Crl::contact (const Rct &r) const
+    {
+        return arrow::contact_crlpnt_rct(*this,r);
+    }
+
+    //Contact with an oriented rectangle
+    bool Crl::contact (const Obb &o) const
+    {
+        return arrow::contact_crlpnt_obb(*this,o);
+    }
+
+    //Contact with a convex polygon
+    bool Crl::contact (const Pol &p) const
+    {
+        return arrow::contact_crlpnt_pol(*this,p);
+    }
+
+    //Contact with a capsule
+    bool Crl::contact (const Cap &c) const
+    {
+        return arrow::contact_cap(*this,c);
+    }
+
+    /*Distance*/
+
+    //Squared distance from a point to the surface of the shape
+    Vct::Mod Crl::sq_dist (const Vct &p) const
+    {
+        Vct::Mod d=(p-r).mod()-s;//Distance from the border
+        return d>0?d*d:0;
+    }
+
+    /*Time to hit*/
+
+    //TTH a generic shape at a given speed
+    Vct::Mod Crl::tth (const Shp &s, const Vct &speed) const
+    {
+        return s.tth(*this,-speed);
+    }
+
+    //TTH a circle at a given speed
+    Vct::Mod Crl::tth (const Crl &c, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_crlpnt(*this,c,speed);
+    }
+
+    //TTH a point at a given speed
+    Vct::Mod Crl::tth (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_crlpnt(*this,p,speed);
+    }
+
+    //TTH a rectangle at a given speed
+    Vct::Mod Crl::tth (const Rct &r, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_rct(*this,r,speed);
+    }
+
+    //TTH a rectangle at a given speed, starting by the region of the hint
+    Vct::Mod Crl::tth (const Rct &r, const Vct &speed, Rgn_hint &hint) const
+    {
+        return arrow::tth_crlpnt_rct(*this,r,speed,hint);
+    }
+
+    //TTH an oriented rectangle at a given speed
+    Vct::Mod Crl::tth (const Obb &o, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_obb(*this,o,speed);
+    }
+
+    //TTH a convex polygon at a given speed
+    Vct::Mod Crl::tth (const Pol &p, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_pol(*this,p,speed);
+    }
+
+    //TTH a capsule at a given speed
+    Vct::Mod Crl::tth (const Cap &c, const Vct &speed) const
+    {
+        return arrow::tth_cap(*this,c,speed);
+    }
+
+    /*Time of impact*/
+
+    //TOI a generic shape at a given speed
+    Toi Crl::toi (const Shp &s, const Vct &speed) const
+    {
+        return arrow::flip_toi(s.toi(*this,-speed),speed);
+    }
+
+    //TOI a circle at a given speed
+    Toi Crl::toi (const Crl &c, const Vct &speed) const
+    {
+        return arrow::toi_crlpnt_crlpnt(*this,c,speed);
+    }
+
+    //TOI a point at a given speed
+    Toi Crl::toi (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::toi_crlpnt_crlpnt(*this,p,speed);
+    }
+
+    //TOI a rectangle at a given speed
+    Toi Crl::toi (const Rct &r, const Vct &speed) const
+    {
+        return arrow::toi_crlpnt_rct(*this,r,speed);
+    }
+
+    //TOI an oriented rectangle at a given speed
+    Toi Crl::toi (const Obb &o, const Vct &speed) const
+    {
+        return arrow::toi_crlpnt_obb(*this,o,speed);
+    }
+
+    //TOI a convex polygon at a given speed
+    Toi Crl::toi (const Pol &p, const Vct &speed) const
+    {
+        return arrow::toi_crlpnt_pol(*this,p,speed);
+    }
+
+    //TOI a capsule at a given speed
+    Toi Crl::toi (const Cap &c, const Vct &speed) const
+    {
+        return arrow::toi_cap(*this,c,speed);
+    }
+
+    /*Movement against a shape*/
+
+    //Movement against a generic shape at a given speed
+    Vct Crl::mov_against (const Shp &s, const Vct &speed) const
+    {
+        return -s.mov_against(*this,-speed);
+    }
+
+    //Movement against a circle at a given speed
+    Vct Crl::mov_against (const Crl &c, const Vct &speed) const
+    {
+        return arrow::mov_against_crlpnt_crlpnt(*this,c,speed);
+    }
+
+    //Movement against a point at a given speed
+    Vct Crl::mov_against (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::mov_against_crlpnt_crlpnt(*this,p,speed);
+    }
+
+    //Movement against a rectangle at a given speed
+    Vct Crl::mov_against (const Rct &r, const Vct &speed) const
+    {
+        return arrow::mov_against_crlpnt_rct(*this,r,speed);
+    }
+
+    //Movement against an oriented rectangle at a given speed
+    Vct Crl::mov_against (const Obb &o, const Vct &speed) const
+    {
+        return arrow::mov_against_crlpnt_obb(*this,o,speed);
+    }
+
+    //Movement against a convex polygon at a given speed
+    Vct Crl::mov_against (const Pol &p, const Vct &speed) const
+    {
+        return arrow::mov_against_crlpnt_pol(*this,p,speed);
+    }
+
+    //Movement against a capsule at a given speed
+    Vct Crl::mov_against (const Cap &c, const Vct &speed) const
+    {
+        return arrow::mov_against_cap(*this,c,speed);
+    }
+
+    /* Pnt */
+
+    /*Contact*/
+
+    //Contact with a generic shape
+    bool Pnt::contact (const Shp &s) const
+    {
+        return s.contact(*this);
+    }
+
+    //Contact with a circle
+    bool Pnt::contact (const Crl &c) const
+    {
+        return arrow::contact_crlpnt_crlpnt(*this,c);
+    }
+
+    //Contact with a point
+    bool Pnt::contact (const Pnt &p) const
+    {
+        return arrow::contact_crlpnt_crlpnt(*this,p);
+    }
+
+    //Contact with a rectangle
+    bool Pnt::contact (const Rct &r) const
+    {
+        return arrow::contact_crlpnt_rct(*this,r);
+    }
+
+    //Contact with an oriented rectangle
+    bool Pnt::contact (const Obb &o) const
+    {
+        return arrow::contact_crlpnt_obb(*this,o);
+    }
+
+    //Contact with a convex polygon
+    bool Pnt::contact (const Pol &p) const
+    {
+        return arrow::contact_crlpnt_pol(*this,p);
+    }
+
+    //Contact with a capsule
+    bool Pnt::contact (const Cap &c) const
+    {
+        return arrow::contact_cap(*this,c);
+    }
+
+    /*Distance*/
+
+    //Squared distance from a point to the surface of the shape
+    Vct::Mod Pnt::sq_dist (const Vct &p) const
+    {
+        return (p-r).sq_mod();
+    }
+
+    /*Time to hit*/
+
+    //TTH a generic shape at a given speed
+    Vct::Mod Pnt::tth (const Shp &s, const Vct &speed) const
+    {
+        return s.tth(*this,-speed);
+    }
+
+    //TTH a circle at a given speed
+    Vct::Mod Pnt::tth (const Crl &c, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_crlpnt(*this,c,speed);
+    }
+
+    //TTH a point at a given speed
+    Vct::Mod Pnt::tth (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_crlpnt(*this,p,speed);
+    }
+
+    //TTH a rectangle at a given speed
+    Vct::Mod Pnt::tth (const Rct &r, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_rct(*this,r,speed);
+    }
+
+    //TTH a rectangle at a given speed, starting by the region of the hint
+    Vct::Mod Pnt::tth (const Rct &r, const Vct &speed, Rgn_hint &hint) const
+    {
+        return arrow::tth_crlpnt_rct(*this,r,speed,hint);
+    }
+
+    //TTH an oriented rectangle at a given speed
+    Vct::Mod Pnt::tth (const Obb &o, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_obb(*this,o,speed);
+    }
+
+    //TTH a convex polygon at a given speed
+    Vct::Mod Pnt::tth (const Pol &p, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_pol(*this,p,speed);
+    }
+
+    //TTH a capsule at a given speed
+    Vct::Mod Pnt::tth (const Cap &c, const Vct &speed) const
+    {
+        return arrow::tth_cap(*this,c,speed);
+    }
+
+    /*Time of impact*/
+
+    //TOI a generic shape at a given speed
+    Toi Pnt::toi (const Shp &s, const Vct &speed) const
+    {
+        return arrow::flip_toi(s.toi(*this,-speed),speed);
+    }
+
+    //TOI a circle at a given speed
+    Toi Pnt::toi (const Crl &c, const Vct &speed) const
+    {
+        return arrow::toi_crlpnt_crlpnt(*this,c,speed);
+    }
+
+    //TOI a point at a given speed
+    Toi Pnt::toi (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::toi_crlpnt_crlpnt(*this,p,speed);
+    }
+
+    //TOI a rectangle at a given speed
+    Toi Pnt::toi (const Rct &r, const Vct &speed) const
+    {
+        return arrow::toi_crlpnt_rct(*this,r,speed);
+    }
+
+    //TOI an oriented rectangle at a given speed
+    Toi Pnt::toi (const Obb &o, const Vct &speed) const
+    {
+        return arrow::toi_crlpnt_obb(*this,o,speed);
+    }
+
+    //TOI a convex polygon at a given speed
+    Toi Pnt::toi (const Pol &p, const Vct &speed) const
+    {
+        return arrow::toi_crlpnt_pol(*this,p,speed);
+    }
+
+    //TOI a capsule at a given speed
+    Toi Pnt::toi (const Cap &c, const Vct &speed) const
+    {
+        return arrow::toi_cap(*this,c,speed);
+    }
+
+    /*Movement against a shape*/
+
+    //Movement against a generic shape at a given speed
+    Vct Pnt::mov_against (const Shp &s, const Vct &speed) const
+    {
+        return -s.mov_against(*this,-speed);
+    }
+
+    //Movement against a circle at a given speed
+    Vct Pnt::mov_against (const Crl &c, const Vct &speed) const
+    {
+        return arrow::mov_against_crlpnt_crlpnt(*this,c,speed);
+    }
+
+    //Movement against a point at a given speed
+    Vct Pnt::mov_against (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::mov_against_crlpnt_crlpnt(*this,p,speed);
+    }
+
+    //Movement against a rectangle at a given speed
+    Vct Pnt::mov_against (const Rct &r, const Vct &speed) const
+    {
+        return arrow::mov_against_crlpnt_rct(*this,r,speed);
+    }
+
+    //Movement against an oriented rectangle at a given speed
+    Vct Pnt::mov_against (const Obb &o, const Vct &speed) const
+    {
+        return arrow::mov_against_crlpnt_obb(*this,o,speed);
+    }
+
+    //Movement against a convex polygon at a given speed
+    Vct Pnt::mov_against (const Pol &p, const Vct &speed) const
+    {
+        return arrow::mov_against_crlpnt_pol(*this,p,speed);
+    }
+
+    //Movement against a capsule at a given speed
+    Vct Pnt::mov_against (const Cap &c, const Vct &speed) const
+    {
+        return arrow::mov_against_cap(*this,c,speed);
+    }
+
+    /* Rct */
+
+    /*Contact*/
+
+    //Contact with a generic shape
+    bool Rct::contact (const Shp &s) const
+    {
+        return s.contact(*this);
+    }
+
+    //Contact with a circle
+    bool Rct::contact (const Crl &c) const
+    {
+        return arrow::contact_crlpnt_rct(c,*this);
+    }
+
+    //Contact with a point
+    bool Rct::contact (const Pnt &p) const
+    {
+        return arrow::contact_crlpnt_rct(p,*this);
+    }
+
+    //Contact with a rectangle
+    bool Rct::contact (const Rct &r) const
+    {
+        return arrow::contact_rct_rct(*this,r);
+    }
+
+    //Contact with an oriented rectangle
+    bool Rct::contact (const Obb &o) const
+    {
+        return arrow::contact_obb_obb(Obb(*this),o);
+    }
+
+    //Contact with a convex polygon
+    bool Rct::contact (const Pol &p) const
+    {
+        return arrow::contact_pol_pol(Pol(*this),p);
+    }
+
+    //Contact with a capsule
+    bool Rct::contact (const Cap &c) const
+    {
+        return arrow::contact_cap(*this,c);
+    }
+
+    /*Distance*/
+
+    //Squared distance from a point to the surface of the shape
+    Vct::Mod Rct::sq_dist (const Vct &p) const
+    {
+        return arrow::mindist_crlpnt_rct(Pnt(p),*this).sq_mod();
+    }
+
+    /*Time to hit*/
+
+    //TTH a generic shape at a given speed
+    Vct::Mod Rct::tth (const Shp &s, const Vct &speed) const
+    {
+        return s.tth(*this,-speed);
+    }
+
+    //TTH a circle at a given speed
+    Vct::Mod Rct::tth (const Crl &c, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_rct(c,*this,-speed);
+    }
+
+    //TTH a point at a given speed
+    Vct::Mod Rct::tth (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_rct(p,*this,-speed);
+    }
+
+    //TTH a rectangle at a given speed
+    Vct::Mod Rct::tth (const Rct &r, const Vct &speed) const
+    {
+        return arrow::tth_rct_rct(*this,r,speed);
+    }
+
+    //TTH an oriented rectangle at a given speed
+    Vct::Mod Rct::tth (const Obb &o, const Vct &speed) const
+    {
+        return arrow::tth_obb_obb(Obb(*this),o,speed);
+    }
+
+    //TTH a convex polygon at a given speed
+    Vct::Mod Rct::tth (const Pol &p, const Vct &speed) const
+    {
+        return arrow::tth_pol_pol(Pol(*this),p,speed);
+    }
+
+    //TTH a capsule at a given speed
+    Vct::Mod Rct::tth (const Cap &c, const Vct &speed) const
+    {
+        return arrow::tth_cap(*this,c,speed);
+    }
+
+    /*Time of impact*/
+
+    //TOI a generic shape at a given speed
+    Toi Rct::toi (const Shp &s, const Vct &speed) const
+    {
+        return arrow::flip_toi(s.toi(*this,-speed),speed);
+    }
+
+    //TOI a circle at a given speed
+    Toi Rct::toi (const Crl &c, const Vct &speed) const
+    {
+        return arrow::flip_toi(arrow::toi_crlpnt_rct(c,*this,-speed),speed);
+    }
+
+    //TOI a point at a given speed
+    Toi Rct::toi (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::flip_toi(arrow::toi_crlpnt_rct(p,*this,-speed),speed);
+    }
+
+    //TOI a rectangle at a given speed
+    Toi Rct::toi (const Rct &r, const Vct &speed) const
+    {
+        return arrow::toi_rct_rct(*this,r,speed);
+    }
+
+    //TOI an oriented rectangle at a given speed
+    Toi Rct::toi (const Obb &o, const Vct &speed) const
+    {
+        return arrow::toi_obb_obb(Obb(*this),o,speed);
+    }
+
+    //TOI a convex polygon at a given speed
+    Toi Rct::toi (const Pol &p, const Vct &speed) const
+    {
+        return arrow::toi_pol_pol(Pol(*this),p,speed);
+    }
+
+    //TOI a capsule at a given speed
+    Toi Rct::toi (const Cap &c, const Vct &speed) const
+    {
+        return arrow::toi_cap(*this,c,speed);
+    }
+
+    /*Movement against a shape*/
+
+    //Movement against a generic shape at a given speed
+    Vct Rct::mov_against (const Shp &s, const Vct &speed) const
+    {
+        return -s.mov_against(*this,-speed);
+    }
+
+    //Movement against a circle at a given speed
+    Vct Rct::mov_against (const Crl &c, const Vct &speed) const
+    {
+        return -arrow::mov_against_crlpnt_rct(c,*this,-speed);
+    }
+
+    //Movement against a point at a given speed
+    Vct Rct::mov_against (const Pnt &p, const Vct &speed) const
+    {
+        return -arrow::mov_against_crlpnt_rct(p,*this,-speed);
+    }
+
+    //Movement against a rectangle at a given speed
+    Vct Rct::mov_against (const Rct &r, const Vct &speed) const
+    {
+        return arrow::mov_against_rct_rct(*this,r,speed);
+    }
+
+    //Movement against an oriented rectangle at a given speed
+    Vct Rct::mov_against (const Obb &o, const Vct &speed) const
+    {
+        return arrow::mov_against_obb_obb(Obb(*this),o,speed);
+    }
+
+    //Movement against a convex polygon at a given speed
+    Vct Rct::mov_against (const Pol &p, const Vct &speed) const
+    {
+        return arrow::mov_against_pol_pol(Pol(*this),p,speed);
+    }
+
+    //Movement against a capsule at a given speed
+    Vct Rct::mov_against (const Cap &c, const Vct &speed) const
+    {
+        return arrow::mov_against_cap(*this,c,speed);
+    }
+
+    /* Obb */
+
+    /*Size*/
+
+    //Set the size (diagonal) of the rectangle that contains the shape completly (scales the rectangle to fit in it)
+    void Obb::set_diagonal (const Vct &ndiag)
+    {
+        Vct d(get_diagonal());
+        if (d.x>0&&d.y>0)//Scale the rectangle
+            s*=std::min(ndiag.x/d.x,ndiag.y/d.y);
+        else//No size to scale, use a square
+        {
+            Vct::Mod side=std::min(ndiag.x,ndiag.y)/(std::abs(u.x)+std::abs(u.y));
+            s=Vct(side,side);
+        }
+        touch();
+    }
+
+    /*Contact*/
+
+    //Contact with a generic shape
+    bool Obb::contact (const Shp &s) const
+    {
+        return s.contact(*this);
+    }
+
+    //Contact with a circle
+    bool Obb::contact (const Crl &c) const
+    {
+        return arrow::contact_crlpnt_obb(c,*this);
+    }
+
+    //Contact with a point
+    bool Obb::contact (const Pnt &p) const
+    {
+        return arrow::contact_crlpnt_obb(p,*this);
+    }
+
+    //Contact with a rectangle
+    bool Obb::contact (const Rct &r) const
+    {
+        return arrow::contact_obb_obb(*this,Obb(r));
+    }
+
+    //Contact with an oriented rectangle
+    bool Obb::contact (const Obb &o) const
+    {
+        return arrow::contact_obb_obb(*this,o);
+    }
+
+    //Contact with a convex polygon
+    bool Obb::contact (const Pol &p) const
+    {
+        return arrow::contact_pol_pol(Pol(*this),p);
+    }
+
+    //Contact with a capsule
+    bool Obb::contact (const Cap &c) const
+    {
+        return arrow::contact_cap(*this,c);
+    }
+
+    /*Distance*/
+
+    //Squared distance from a point to the surface of the shape
+    Vct::Mod Obb::sq_dist (const Vct &p) const
+    {
+        return arrow::mindist_crlpnt_rct(Pnt(arrow::to_local_obb(*this,p-r)),arrow::local_obb(*this)).sq_mod();
+    }
+
+    /*Time to hit*/
+
+    //TTH a generic shape at a given speed
+    Vct::Mod Obb::tth (const Shp &s, const Vct &speed) const
+    {
+        return s.tth(*this,-speed);
+    }
+
+    //TTH a circle at a given speed
+    Vct::Mod Obb::tth (const Crl &c, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_obb(c,*this,-speed);
+    }
+
+    //TTH a point at a given speed
+    Vct::Mod Obb::tth (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::tth_crlpnt_obb(p,*this,-speed);
+    }
+
+    //TTH a rectangle at a given speed
+    Vct::Mod Obb::tth (const Rct &r, const Vct &speed) const
+    {
+        return arrow::tth_obb_obb(*this,Obb(r),speed);
+    }
+
+    //TTH an oriented rectangle at a given speed
+    Vct::Mod Obb::tth (const Obb &o, const Vct &speed) const
+    {
+        return arrow::tth_obb_obb(*this,o,speed);
+    }
+
+    //TTH a convex polygon at a given speed
+    Vct::Mod Obb::tth (const Pol &p, const Vct &speed) const
+    {
+        return arrow::tth_pol_pol(Pol(*this),p,speed);
+    }
+
+    //TTH a capsule at a given speed
+    Vct::Mod Obb::tth (const Cap &c, const Vct &speed) const
+    {
+        return arrow::tth_cap(*this,c,speed);
+    }
+
+    /*Time of impact*/
+
+    //TOI a generic shape at a given speed
+    Toi Obb::toi (const Shp &s, const Vct &speed) const
+    {
+        return arrow::flip_toi(s.toi(*this,-speed),speed);
+    }
+
+    //TOI a circle at a given speed
+    Toi Obb::toi (const Crl &c, const Vct &speed) const
+    {
+        return arrow::flip_toi(arrow::toi_crlpnt_obb(c,*this,-speed),speed);
+    }
+
+    //TOI a point at a given speed
+    Toi Obb::toi (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::flip_toi(arrow::toi_crlpnt_obb(p,*this,-speed),speed);
+    }
+
+    //TOI a rectangle at a given speed
+    Toi Obb::toi (const Rct &r, const Vct &speed) const
+    {
+        return arrow::toi_obb_obb(*this,Obb(r),speed);
+    }
+
+    //TOI an oriented rectangle at a given speed
+    Toi Obb::toi (const Obb &o, const Vct &speed) const
+    {
+        return arrow::toi_obb_obb(*this,o,speed);
+    }
+
+    //TOI a convex polygon at a given speed
+    Toi Obb::toi (const Pol &p, const Vct &speed) const
+    {
+        return arrow::toi_pol_pol(Pol(*this),p,speed);
+    }
+
+    //TOI a capsule at a given speed
+    Toi Obb::toi (const Cap &c, const Vct &speed) const
+    {
+        return arrow::toi_cap(*this,c,speed);
+    }
+
+    /*Movement against a shape*/
+
+    //Movement against a generic shape at a given speed
+    Vct Obb::mov_against (const Shp &s, const Vct &speed) const
+    {
+        return -s.mov_against(*this,-speed);
+    }
+
+    //Movement against a circle at a given speed
+    Vct Obb::mov_against (const Crl &c, const Vct &speed) const
+    {
+        return -arrow::mov_against_crlpnt_obb(c,*this,-speed);
+    }
+
+    //Movement against a point at a given speed
+    Vct Obb::mov_against (const Pnt &p, const Vct &speed) const
+    {
+        return -arrow::mov_against_crlpnt_obb(p,*this,-speed);
+    }
+
+    //Movement against a rectangle at a given speed
+    Vct Obb::mov_against (const Rct &r, const Vct &speed) const
     {
-        //Get the tth from this circle to the rectangle
-        Vct::Mod tth=s.tth(r,speed);
+        return arrow::mov_against_obb_obb(*this,Obb(r),speed);
+    }
 
-        //Check if the TTH limits the movement
-        if (tth>=1||tth<0)//No limit
-            return speed;
+    //Movement against an oriented rectangle at a given speed
+    Vct Obb::mov_against (const Obb &o, const Vct &speed) const
+    {
+        return arrow::mov_against_obb_obb(*this,o,speed);
+    }
 
-        //Speed is limited, process it
-        Vct speed_free(speed,tth);//Speed not limited by the tth
-        Crl ccopy(s.get_pos_center()+speed_free,s.get_size());//Copy of the circle
+    //Movement against a convex polygon at a given speed
+    Vct Obb::mov_against (const Pol &p, const Vct &speed) const
+    {
+        return arrow::mov_against_pol_pol(Pol(*this),p,speed);
+    }
 
-        int px,py;//Relative positions of the circle
-        rel_pos_crlpnt_rct(ccopy,r,px,py);
+    //Movement against a capsule at a given speed
+    Vct Obb::mov_against (const Cap &c, const Vct &speed) const
+    {
+        return arrow::mov_against_cap(*this,c,speed);
+    }
 
-        //Process the remaining speed
-        Vct speed_left(speed-speed_free);
+    /* Pol */
 
-        //Check the type of contact
-        if (px&&py)//Corner contact
-        {
-            //Get the corner of the rect
-            Vct corner(r.get_pos_corner());
-            if (px>0)corner.x+=r.get_diagonal().x;
-            if (py>0)corner.y+=r.get_diagonal().y;
+    /*Constructors*/
 
-            //Move the circle against the corner
-            speed_left=ccopy.mov_against(Pnt(corner),speed_left);
-        }
-        else//Side contact or center contact
-        {
-            if (!(px||py))//Center of circle inside rectangle
-            {
-                speed_left=ccopy.mov_against(Crl(r.get_pos_center(),r.get_size()),speed_left);//Move against the rectangle's center
-            }
-            else//Side contact
-            {
-                if (px)//X side
-                {
-                    if (px<0)//Circle at the left
-                    {
-                        if (speed_left.x>0)speed_left.x=0;//Restrict movement to the right
-                    }
-                    else//Circle at the right
-                    {
-                        if (speed_left.x<0)speed_left.x=0;//Restrict movement to the left
-                    }
-                }
-                else//Y side
-                {
-                    if (py<0)//Circle at the top
-                    {
-                        if (speed_left.y>0)speed_left.y=0;//Restrict movement to bottom
-                    }
-                    else//Circle at the bottom
-                    {
-                        if (speed_left.y<0)speed_left.y=0;//Restrict movement to the top
-                    }
-                }
-            }
-        }
+    //Constructor from a rectangle
+    Pol::Pol (const Rct &nrct)
+    :Pol(Obb(nrct))
+    {}
 
-        //Return the not limited movement and the limited movement
-        return speed_free+speed_left;
+    //Constructor from an oriented rectangle
+    Pol::Pol (const Obb &nobb)
+    {
+        Vct c(nobb.get_pos_center());
+        Vct u(nobb.get_axis_x(),0.5*nobb.get_side().x), v(nobb.get_axis_y(),0.5*nobb.get_side().y);
+        set_vertices(std::vector<Vct>{c-u-v,c+u-v,c+u+v,c-u+v});
     }
 
+    /*Vertices*/
 
-    //(Rct, Rct)
-    Vct mov_against_rct_rct (const Rct& r1, const Rct& r2, const Vct& speed)
+    //Set the vertices, the center is moved to their centroid
+    void Pol::set_vertices (const std::vector<Vct> &nvert)
     {
-        //Get the tth from the first rectangle to the second
-        Vct::Mod tth=r1.tth(r2,speed);
-
-        //Check if the TTH limits the movement
-        if (tth>=1||tth<0)//No limit
-            return speed;
-
-        //Speed is limited, process it
-        Vct speed_free(speed,tth);//Speed not limited by the tth
-        Rct rcopy(r1);//Copy of the rectangle
-        rcopy.mov(speed_free);
-
-        //Get the relative position
-        int px,py;
-        rel_pos_rct_rct(rcopy,r2,px,py);
-
-        //Process the remaining speed
-        Vct speed_left(speed-speed_free);
-
-        //Check the type of contact
+        std::size_t n=nvert.size();
 
-        //Corner contact
-        if (std::abs(px)>=2&&std::abs(py)>=2)
+        //Centroid (of the area, or of the vertices if there's no area) and signed area
+        Vct::Mod area=0;
+        Vct c, avg;
+        for (std::size_t i=0;i<n;i++)
         {
-            //Check if the speed goes on the same direction as the corner (inside the Rct)
-            if (speed_left.x*px>0&&speed_left.y*py>0)//Only one component of the speed is to be kept (priority on X)
-            {
-                if (std::abs(speed_left.x)>=std::abs(speed_left.y))
-                    speed_left.y=0;//X is kept
-                else
-                    speed_left.x=0;//Y is kept
-            }
-            //Else, the speed does not need to be modified
+            const Vct &a=nvert[i], &b=nvert[i+1<n?i+1:0];
+            Vct::Mod w=a.x*b.y-b.x*a.y;
+            area+=w;
+            c+=(a+b)*w;
+            avg+=a;
         }
-        else//Side contact or center contact
+        if (std::abs(area)>EPSILON_COMP)
+            r=Vct(c,1/(3*area));
+        else
+            r=n?Vct(avg,1.0/n):Vct();
+
+        //Vertices relative to the center, counter clockwise (positive area)
+        px.resize(n);
+        py.resize(n);
+        for (std::size_t i=0;i<n;i++)
         {
-            if (std::abs(px)>=2)//Border contact on left/right
-            {
-                if (speed_left.x*px>0)//If the speed goes towards the center, limit it
-                    speed_left.x=0;
-            }
-            else if (std::abs(py)>=2)//Border contact on top bottom
-            {
-                if (speed_left.y*py>0)//If the speed goes towards the center, limit it
-                    speed_left.y=0;
-            }
-            else//Inside contact
-            {
-                if (speed_left.x*px>0)//X limit
-                    speed_left.x=0;
-                if (speed_left.y*py>0)//Y limit
-                    speed_left.y=0;
-            }
+            const Vct &v=nvert[area<0?n-1-i:i];
+            px[i]=v.x-r.x;
+            py[i]=v.y-r.y;
         }
 
-        //Return the speed
-        return speed_free+speed_left;
+        //Outer normals, bounds and radius
+        nx.resize(n);
+        ny.resize(n);
+        lo=hi=Vct();
+        rad=0;
+        for (std::size_t i=0;i<n;i++)
+        {
+            std::size_t j=i+1<n?i+1:0;
+            Vct e(px[j]-px[i],py[j]-py[i]);
+            if (e)
+                e.unitary();
+            nx[i]=e.y;
+            ny[i]=-e.x;
+
+            Vct v(px[i],py[i]);
+            if (!i)
+                lo=hi=v;
+            lo=Vct(std::min(lo.x,v.x),std::min(lo.y,v.y));
+            hi=Vct(std::max(hi.x,v.x),std::max(hi.y,v.y));
+            rad=std::max(rad,v.mod());
+        }
+        touch();
     }
 
-    /* Crl */
+    //Scale the polygon from its center
+    void Pol::scale (Vct::Mod k)
+    {
+        for (std::size_t i=0;i<px.size();i++)
+        {
+            px[i]*=k;
+            py[i]*=k;
+        }
+        lo*=k;
+        hi*=k;
+        rad*=k;
+        touch();
+    }
 
     /*Contact*/
 
     //Contact with a generic shape
-    bool Crl::contact (const Shp &s) const
+    bool Pol::contact (const Shp &s) const
     {
         return s.contact(*this);
     }
 
     //Contact with a circle
-    bool Crl::contact (const Crl &c) const
+    bool Pol::contact (const Crl &c) const
     {
-        return arrow::contact_crlpnt_crlpnt(*this,c);
+        return arrow::contact_crlpnt_pol(c,*this);
     }
 
     //Contact with a point
-    bool Crl::contact (const Pnt &p) const
+    bool Pol::contact (const Pnt &p) const
     {
-        return arrow::contact_crlpnt_crlpnt(*this,p);
+        return arrow::contact_crlpnt_pol(p,*this);
     }
 
     //Contact with a rectangle
-    bool Crl::contact (const Rct &r) const
+    bool Pol::contact (const Rct &r) const
     {
-        return arrow::contact_crlpnt_rct(*this,r);
+        return arrow::contact_pol_pol(*this,Pol(r));
     }
 
-    /*Time to hit*/
-
-    //TTH a generic shape at a given speed
-    Vct::Mod Crl::tth (const Shp &s, const Vct &speed) const
+    //Contact with an oriented rectangle
+    bool Pol::contact (const Obb &o) const
     {
-        return s.tth(*this,-speed);
+        return arrow::contact_pol_pol(*this,Pol(o));
     }
 
-    //TTH a circle at a given speed
-    Vct::Mod Crl::tth (const Crl &c, const Vct &speed) const
+    //Contact with a convex polygon
+    bool Pol::contact (const Pol &p) const
     {
-        return arrow::tth_crlpnt_crlpnt(*this,c,speed);
+        return arrow::contact_pol_pol(*this,p);
     }
 
-    //TTH a point at a given speed
-    Vct::Mod Crl::tth (const Pnt &p, const Vct &speed) const
+    //Contact with a capsule
+    bool Pol::contact (const Cap &c) const
     {
-        return arrow::tth_crlpnt_crlpnt(*this,p,speed);
+        return arrow::contact_cap(*this,c);
     }
 
-    //TTH a rectangle at a given speed
-    Vct::Mod Crl::tth (const Rct &r, const Vct &speed) const
+    /*Distance*/
+
+    //Squared distance from a point to the surface of the shape
+    Vct::Mod Pol::sq_dist (const Vct &p) const
     {
-        return arrow::tth_crlpnt_rct(*this,r,speed);
+        std::size_t side;
+        bool end;
+        Vct c;
+        if (px.empty()||arrow::inside_pol(arrow::view_pol(*this),p-r,side))
+            return 0;
+        return arrow::closest_pol(arrow::view_pol(*this),p-r,side,end,c);
     }
 
-    /*Movement against a shape*/
+    /*Time to hit*/
 
-    //Movement against a generic shape at a given speed
-    Vct Crl::mov_against (const Shp &s, const Vct &speed) const
+    //TTH a generic shape at a given speed
+    Vct::Mod Pol::tth (const Shp &s, const Vct &speed) const
     {
-        return -s.mov_against(*this,-speed);
+        return s.tth(*this,-speed);
     }
 
-    //Movement against a circle at a given speed
-    Vct Crl::mov_against (const Crl &c, const Vct &speed) const
+    //TTH a circle at a given speed
+    Vct::Mod Pol::tth (const Crl &c, const Vct &speed) const
     {
-        return arrow::mov_against_crlpnt_crlpnt(*this,c,speed);
+        return arrow::tth_crlpnt_pol(c,*this,-speed);
     }
 
-    //Movement against a point at a given speed
-    Vct Crl::mov_against (const Pnt &p, const Vct &speed) const
+    //TTH a point at a given speed
+    Vct::Mod Pol::tth (const Pnt &p, const Vct &speed) const
     {
-        return arrow::mov_against_crlpnt_crlpnt(*this,p,speed);
+        return arrow::tth_crlpnt_pol(p,*this,-speed);
     }
 
-    //Movement against a rectangle at a given speed
-    Vct Crl::mov_against (const Rct &r, const Vct &speed) const
+    //TTH a rectangle at a given speed
+    Vct::Mod Pol::tth (const Rct &r, const Vct &speed) const
     {
-        return arrow::mov_against_crlpnt_rct(*this,r,speed);
+        return arrow::tth_pol_pol(*this,Pol(r),speed);
     }
 
-    /* Pnt */
-
-    /*Contact*/
+    //TTH an oriented rectangle at a given speed
+    Vct::Mod Pol::tth (const Obb &o, const Vct &speed) const
+    {
+        return arrow::tth_pol_pol(*this,Pol(o),speed);
+    }
 
-    //Contact with a generic shape
-    bool Pnt::contact (const Shp &s) const
+    //TTH a convex polygon at a given speed
+    Vct::Mod Pol::tth (const Pol &p, const Vct &speed) const
     {
-        return s.contact(*this);
+        return arrow::tth_pol_pol(*this,p,speed);
     }
 
-    //Contact with a circle
-    bool Pnt::contact (const Crl &c) const
+    //TTH a capsule at a given speed
+    Vct::Mod Pol::tth (const Cap &c, const Vct &speed) const
     {
-        return arrow::contact_crlpnt_crlpnt(*this,c);
+        return arrow::tth_cap(*this,c,speed);
     }
 
-    //Contact with a point
-    bool Pnt::contact (const Pnt &p) const
+    /*Time of impact*/
+
+    //TOI a generic shape at a given speed
+    Toi Pol::toi (const Shp &s, const Vct &speed) const
     {
-        return arrow::contact_crlpnt_crlpnt(*this,p);
+        return arrow::flip_toi(s.toi(*this,-speed),speed);
     }
 
-    //Contact with a rectangle
-    bool Pnt::contact (const Rct &r) const
+    //TOI a circle at a given speed
+    Toi Pol::toi (const Crl &c, const Vct &speed) const
     {
-        return arrow::contact_crlpnt_rct(*this,r);
+        return arrow::flip_toi(arrow::toi_crlpnt_pol(c,*this,-speed),speed);
     }
 
-    /*Time to hit*/
+    //TOI a point at a given speed
+    Toi Pol::toi (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::flip_toi(arrow::toi_crlpnt_pol(p,*this,-speed),speed);
+    }
 
-    //TTH a generic shape at a given speed
-    Vct::Mod Pnt::tth (const Shp &s, const Vct &speed) const
+    //TOI a rectangle at a given speed
+    Toi Pol::toi (const Rct &r, const Vct &speed) const
     {
-        return s.tth(*this,-speed);
+        return arrow::toi_pol_pol(*this,Pol(r),speed);
     }
 
-    //TTH a circle at a given speed
-    Vct::Mod Pnt::tth (const Crl &c, const Vct &speed) const
+    //TOI an oriented rectangle at a given speed
+    Toi Pol::toi (const Obb &o, const Vct &speed) const
     {
-        return arrow::tth_crlpnt_crlpnt(*this,c,speed);
+        return arrow::toi_pol_pol(*this,Pol(o),speed);
     }
 
-    //TTH a point at a given speed
-    Vct::Mod Pnt::tth (const Pnt &p, const Vct &speed) const
+    //TOI a convex polygon at a given speed
+    Toi Pol::toi (const Pol &p, const Vct &speed) const
     {
-        return arrow::tth_crlpnt_crlpnt(*this,p,speed);
+        return arrow::toi_pol_pol(*this,p,speed);
     }
 
-    //TTH a rectangle at a given speed
-    Vct::Mod Pnt::tth (const Rct &r, const Vct &speed) const
+    //TOI a capsule at a given speed
+    Toi Pol::toi (const Cap &c, const Vct &speed) const
     {
-        return arrow::tth_crlpnt_rct(*this,r,speed);
+        return arrow::toi_cap(*this,c,speed);
     }
 
     /*Movement against a shape*/
 
     //Movement against a generic shape at a given speed
-    Vct Pnt::mov_against (const Shp &s, const Vct &speed) const
+    Vct Pol::mov_against (const Shp &s, const Vct &speed) const
     {
         return -s.mov_against(*this,-speed);
     }
 
     //Movement against a circle at a given speed
-    Vct Pnt::mov_against (const Crl &c, const Vct &speed) const
+    Vct Pol::mov_against (const Crl &c, const Vct &speed) const
     {
-        return arrow::mov_against_crlpnt_crlpnt(*this,c,speed);
+        return -arrow::mov_against_crlpnt_pol(c,*this,-speed);
     }
 
     //Movement against a point at a given speed
-    Vct Pnt::mov_against (const Pnt &p, const Vct &speed) const
+    Vct Pol::mov_against (const Pnt &p, const Vct &speed) const
     {
-        return arrow::mov_against_crlpnt_crlpnt(*this,p,speed);
+        return -arrow::mov_against_crlpnt_pol(p,*this,-speed);
     }
 
     //Movement against a rectangle at a given speed
-    Vct Pnt::mov_against (const Rct &r, const Vct &speed) const
+    Vct Pol::mov_against (const Rct &r, const Vct &speed) const
     {
-        return arrow::mov_against_crlpnt_rct(*this,r,speed);
+        return arrow::mov_against_pol_pol(*this,Pol(r),speed);
     }
 
-    /* Rct */
+    //Movement against an oriented rectangle at a given speed
+    Vct Pol::mov_against (const Obb &o, const Vct &speed) const
+    {
+        return arrow::mov_against_pol_pol(*this,Pol(o),speed);
+    }
+
+    //Movement against a convex polygon at a given speed
+    Vct Pol::mov_against (const Pol &p, const Vct &speed) const
+    {
+        return arrow::mov_against_pol_pol(*this,p,speed);
+    }
+
+    //Movement against a capsule at a given speed
+    Vct Pol::mov_against (const Cap &c, const Vct &speed) const
+    {
+        return arrow::mov_against_cap(*this,c,speed);
+    }
+
+    /* Cap */
+
+    /*Size*/
+
+    //Set the size of the circle that contains the shape completly (scales the capsule)
+    void Cap::set_size (Vct::Mod nsize)
+    {
+        if (l+s>0)
+        {
+            Vct::Mod k=nsize/(l+s);
+            l*=k;
+            s*=k;
+        }
+        else
+            s=nsize;
+        touch();
+    }
+
+    //Set the size (diagonal) of the rectangle that contains the shape completly (scales the capsule to fit in it)
+    void Cap::set_diagonal (const Vct &ndiag)
+    {
+        Vct d(get_diagonal());
+        if (d.x>0&&d.y>0)
+        {
+            Vct::Mod k=std::min(ndiag.x/d.x,ndiag.y/d.y);
+            l*=k;
+            s*=k;
+            touch();
+        }
+    }
 
     /*Contact*/
 
     //Contact with a generic shape
-    bool Rct::contact (const Shp &s) const
+    bool Cap::contact (const Shp &s) const
     {
         return s.contact(*this);
     }
 
     //Contact with a circle
-    bool Rct::contact (const Crl &c) const
+    bool Cap::contact (const Crl &c) const
     {
-        return arrow::contact_crlpnt_rct(c,*this);
+        return arrow::contact_cap(*this,c);
     }
 
     //Contact with a point
-    bool Rct::contact (const Pnt &p) const
+    bool Cap::contact (const Pnt &p) const
     {
-        return arrow::contact_crlpnt_rct(p,*this);
+        return arrow::contact_cap(*this,p);
     }
 
     //Contact with a rectangle
-    bool Rct::contact (const Rct &r) const
+    bool Cap::contact (const Rct &r) const
     {
-        return arrow::contact_rct_rct(*this,r);
+        return arrow::contact_cap(*this,r);
+    }
+
+    //Contact with an oriented rectangle
+    bool Cap::contact (const Obb &o) const
+    {
+        return arrow::contact_cap(*this,o);
+    }
+
+    //Contact with a convex polygon
+    bool Cap::contact (const Pol &p) const
+    {
+        return arrow::contact_cap(*this,p);
+    }
+
+    //Contact with a capsule
+    bool Cap::contact (const Cap &c) const
+    {
+        return arrow::contact_cap(*this,c);
+    }
+
+    /*Distance*/
+
+    //Squared distance from a point to the surface of the shape
+    Vct::Mod Cap::sq_dist (const Vct &p) const
+    {
+        Vct::Mod k=std::max(-l,std::min(l,arrow::dot(p-r,u)));//Closest point of the segment
+        Vct::Mod d=(p-(r+u*k)).mod()-s;//Distance from the border
+        return d>0?d*d:0;
     }
 
     /*Time to hit*/
 
     //TTH a generic shape at a given speed
-    Vct::Mod Rct::tth (const Shp &s, const Vct &speed) const
+    Vct::Mod Cap::tth (const Shp &s, const Vct &speed) const
     {
         return s.tth(*this,-speed);
     }
 
     //TTH a circle at a given speed
-    Vct::Mod Rct::tth (const Crl &c, const Vct &speed) const
+    Vct::Mod Cap::tth (const Crl &c, const Vct &speed) const
     {
-        return arrow::tth_crlpnt_rct(c,*this,-speed);
+        return arrow::tth_cap(*this,c,speed);
     }
 
     //TTH a point at a given speed
-    Vct::Mod Rct::tth (const Pnt &p, const Vct &speed) const
+    Vct::Mod Cap::tth (const Pnt &p, const Vct &speed) const
     {
-        return arrow::tth_crlpnt_rct(p,*this,-speed);
+        return arrow::tth_cap(*this,p,speed);
     }
 
     //TTH a rectangle at a given speed
-    Vct::Mod Rct::tth (const Rct &r, const Vct &speed) const
+    Vct::Mod Cap::tth (const Rct &r, const Vct &speed) const
     {
-        return arrow::tth_rct_rct(*this,r,speed);
+        return arrow::tth_cap(*this,r,speed);
+    }
+
+    //TTH an oriented rectangle at a given speed
+    Vct::Mod Cap::tth (const Obb &o, const Vct &speed) const
+    {
+        return arrow::tth_cap(*this,o,speed);
+    }
+
+    //TTH a convex polygon at a given speed
+    Vct::Mod Cap::tth (const Pol &p, const Vct &speed) const
+    {
+        return arrow::tth_cap(*this,p,speed);
+    }
+
+    //TTH a capsule at a given speed
+    Vct::Mod Cap::tth (const Cap &c, const Vct &speed) const
+    {
+        return arrow::tth_cap(*this,c,speed);
+    }
+
+    /*Time of impact*/
+
+    //TOI a generic shape at a given speed
+    Toi Cap::toi (const Shp &s, const Vct &speed) const
+    {
+        return arrow::flip_toi(s.toi(*this,-speed),speed);
+    }
+
+    //TOI a circle at a given speed
+    Toi Cap::toi (const Crl &c, const Vct &speed) const
+    {
+        return arrow::toi_cap(*this,c,speed);
+    }
+
+    //TOI a point at a given speed
+    Toi Cap::toi (const Pnt &p, const Vct &speed) const
+    {
+        return arrow::toi_cap(*this,p,speed);
+    }
+
+    //TOI a rectangle at a given speed
+    Toi Cap::toi (const Rct &r, const Vct &speed) const
+    {
+        return arrow::toi_cap(*this,r,speed);
+    }
+
+    //TOI an oriented rectangle at a given speed
+    Toi Cap::toi (const Obb &o, const Vct &speed) const
+    {
+        return arrow::toi_cap(*this,o,speed);
+    }
+
+    //TOI a convex polygon at a given speed
+    Toi Cap::toi (const Pol &p, const Vct &speed) const
+    {
+        return arrow::toi_cap(*this,p,speed);
+    }
+
+    //TOI a capsule at a given speed
+    Toi Cap::toi (const Cap &c, const Vct &speed) const
+    {
+        return arrow::toi_cap(*this,c,speed);
     }
 
     /*Movement against a shape*/
 
     //Movement against a generic shape at a given speed
-    Vct Rct::mov_against (const Shp &s, const Vct &speed) const
+    Vct Cap::mov_against (const Shp &s, const Vct &speed) const
     {
         return -s.mov_against(*this,-speed);
     }
 
     //Movement against a circle at a given speed
-    Vct Rct::mov_against (const Crl &c, const Vct &speed) const
+    Vct Cap::mov_against (const Crl &c, const Vct &speed) const
     {
-        return -arrow::mov_against_crlpnt_rct(c,*this,-speed);
+        return arrow::mov_against_cap(*this,c,speed);
     }
 
     //Movement against a point at a given speed
-    Vct Rct::mov_against (const Pnt &p, const Vct &speed) const
+    Vct Cap::mov_against (const Pnt &p, const Vct &speed) const
     {
-        return -arrow::mov_against_crlpnt_rct(p,*this,-speed);
+        return arrow::mov_against_cap(*this,p,speed);
     }
 
     //Movement against a rectangle at a given speed
-    Vct Rct::mov_against (const Rct &r, const Vct &speed) const
+    Vct Cap::mov_against (const Rct &r, const Vct &speed) const
     {
-        return arrow::mov_against_rct_rct(*this,r,speed);
+        return arrow::mov_against_cap(*this,r,speed);
     }
 
-    /* Set */
-
-    /*TTH*/
+    //Movement against an oriented rectangle at a given speed
+    Vct Cap::mov_against (const Obb &o, const Vct &speed) const
+    {
+        return arrow::mov_against_cap(*this,o,speed);
+    }
 
-    //TTH a point
-    Set Set::tth(Value v, Value speed) const
+    //Movement against a convex polygon at a given speed
+    Vct Cap::mov_against (const Pol &p, const Vct &speed) const
     {
-        //Check for static or dynamic tth
-        if (speed)//Dynamic tth
-        {
-            Set rv(v-get_max(),v-get_min());//Distance
-            rv*=(1.0/speed);//Get the distance to time dividing it by the speed
-            return rv;
-        }
-        else//Static tth
-        {
-            //Check if the value is inside the set
-            if (check_value(v))
-                return Set(DEF_MIN_LIMIT,DEF_MAX_LIMIT);//Default values hold the appropiate time value for infinite
-            else
-                return Set(DEF_MIN_NULL,DEF_MAX_NULL);//Null value indicates that there's no time value that puts the set in contact with it
-        }
+        return arrow::mov_against_cap(*this,p,speed);
     }
 
-    //TTH a set
-    Set Set::tth(const Set& s, Value speed) const
+    //Movement against a capsule at a given speed
+    Vct Cap::mov_against (const Cap &c, const Vct &speed) const
     {
-        return max_union(tth(s.get_min(),speed),tth(s.get_max(),speed));
+        return arrow::mov_against_cap(*this,c,speed);
     }
 
 }}//End of namespace
@@ -0,0 +1,220 @@
+/*
+ * FDX_Igr.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Igr
+    Batched integration of positions and speeds
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Igr.hpp"
+
+//Tracing
+#include "../include/FDX_Trc.hpp"
+
+//End of the ranges of the workers
+#include <mutex>
+#include <condition_variable>
+
+//Ranges of the threads
+#include <algorithm>
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Kernels
+    */
+
+    /*Integrate the bodies in [first,last) with a method, with or without accelerations
+      Every value is computed and then selected, so there are no branches in the loop.
+      The columns never overlap (too many pointers to check it at run time before vectorizing)*/
+    template <Igr::Method M, bool ACC>
+    static void igr_kernel (Vct::Coord *__restrict x, Vct::Coord *__restrict y, Vct::Coord *__restrict vx, Vct::Coord *__restrict vy,
+                            const Vct::Coord *__restrict ax, const Vct::Coord *__restrict ay,
+                            Vct::Mod dt, Vct::Mod max_speed, std::size_t first, std::size_t last)
+    {
+        Vct::Mod h=0.5*dt*dt, sq_max=max_speed*max_speed;
+        for (std::size_t i=first;i<last;i++)
+        {
+            Vct::Coord px=x[i], py=y[i], sx=vx[i], sy=vy[i];
+            Vct::Coord gx=ACC?ax[i]:0, gy=ACC?ay[i]:0;
+
+            //Position with the speed before the step
+            if (M==Igr::Method::euler)
+            {
+                px+=sx*dt;
+                py+=sy*dt;
+            }
+            else if (M==Igr::Method::verlet)
+            {
+                px+=sx*dt+gx*h;
+                py+=sy*dt+gy*h;
+            }
+
+            //Speed, limited as Vct::limmod does
+            sx+=gx*dt;
+            sy+=gy*dt;
+            Vct::Mod sq=sx*sx+sy*sy;
+            Vct::Mod k=max_speed/std::sqrt(sq>0?sq:1);
+            bool lim=sq>sq_max;
+            sx=lim?sx*k:sx;
+            sy=lim?sy*k:sy;
+
+            //Position with the speed after the step
+            if (M==Igr::Method::semi_euler)
+            {
+                px+=sx*dt;
+                py+=sy*dt;
+            }
+
+            x[i]=px;
+            y[i]=py;
+            vx[i]=sx;
+            vy[i]=sy;
+        }
+    }
+
+    //Integrate the bodies in [first,last) with a method
+    template <Igr::Method M>
+    static void igr_kernel (Vca &pos, Vca &spd, const Vca &acc, Vct::Mod dt, Vct::Mod max_speed, std::size_t first, std::size_t last)
+    {
+        if (acc.empty())
+            igr_kernel<M,false>(pos.x.data(),pos.y.data(),spd.x.data(),spd.y.data(),nullptr,nullptr,dt,max_speed,first,last);
+        else
+            igr_kernel<M,true>(pos.x.data(),pos.y.data(),spd.x.data(),spd.y.data(),acc.x.data(),acc.y.data(),dt,max_speed,first,last);
+    }
+
+    /*
+        Integrator
+    */
+
+    //Smallest number of bodies given to a thread
+    constexpr std::size_t Igr::MIN_CHUNK;
+
+    /* Steps */
+
+    //Integrate the positions and speeds during dt with the given accelerations
+    void Igr::step (Vca &pos, Vca &spd, const Vca &acc, Mod dt) const
+    {
+        FDX_TRC_SPAN("integrate");
+        split(pos.size(),[&](std::size_t first, std::size_t last)
+        {
+            step_range(pos,spd,acc,dt,first,last);
+        });
+    }
+
+    //Integrate the bodies of a store during dt and update the hierarchy over their boxes
+    void Igr::step (Bdy_store &s, const Vca &acc, Mod dt, Bvh *bvh)
+    {
+        {
+            FDX_TRC_SPAN("integrate");
+            boxes.resize(s.size());
+            Box *out=boxes.data();
+            split(s.size(),[&](std::size_t first, std::size_t last)
+            {
+                //The boxes of a range are computed while its columns are still in cache
+                step_range(s.positions(),s.speeds(),acc,dt,first,last);
+                s.bounds(first,last,out+first);
+            });
+        }
+
+        if (bvh)
+        {
+            FDX_TRC_SPAN("broadphase");
+            if (bvh->count()!=boxes.size())//Bodies added or removed, build again
+                bvh->build(boxes);
+            else
+                bvh->refit(boxes);
+        }
+    }
+
+    //Integrate the bodies in [first,last)
+    void Igr::step_range (Vca &pos, Vca &spd, const Vca &acc, Mod dt, std::size_t first, std::size_t last) const
+    {
+        switch (method)
+        {
+            case Method::euler:
+                igr_kernel<Method::euler>(pos,spd,acc,dt,max_speed,first,last);
+                break;
+            case Method::semi_euler:
+                igr_kernel<Method::semi_euler>(pos,spd,acc,dt,max_speed,first,last);
+                break;
+            case Method::verlet:
+                igr_kernel<Method::verlet>(pos,spd,acc,dt,max_speed,first,last);
+                break;
+        }
+    }
+
+    //Call f(first,last) over the ranges of [0,n) given to each thread
+    template <class F>
+    void Igr::split (std::size_t n, F f) const
+    {
+        //Threads used, each one with at least MIN_CHUNK bodies
+        std::size_t t=std::max<std::size_t>(1,std::min<std::size_t>(threads,n/MIN_CHUNK));
+        if (t==1)
+        {
+            f(0,n);
+            return;
+        }
+
+        //Ranges left to the workers, the last one to end wakes the caller
+        std::mutex m;
+        std::condition_variable done;
+        std::size_t left=0;
+
+        //The caller takes the first range, the others are given to the workers of the pool (they live between steps)
+        Wrk &w=pool?*pool:Wrk::shared();
+        std::size_t chunk=(n+t-1)/t;
+        for (std::size_t first=chunk;first<n;first+=chunk)
+        {
+            {
+                std::lock_guard<std::mutex> g(m);
+                left++;
+            }
+            std::size_t last=std::min(n,first+chunk);
+            w.post([&f,&m,&done,&left,first,last]
+            {
+                f(first,last);
+                std::lock_guard<std::mutex> g(m);
+                if (!--left)
+                    done.notify_one();
+            });
+        }
+        f(0,chunk);
+
+        std::unique_lock<std::mutex> g(m);
+        done.wait(g,[&left]{return !left;});
+    }
+
+}}//End of namespace
@@ -0,0 +1,117 @@
+/*
+ * FDX_Itv.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Itv
+    Index of intervals (sets) for 1D queries
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Itv.hpp"
+
+//Sorting
+#include <algorithm>
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Index of intervals
+    */
+
+    /* Sets */
+
+    //Remove every set
+    void Itv::clear()
+    {
+        pending.clear();
+        mins.clear();
+        maxs.clear();
+        sub_max.clear();
+        ids.clear();
+    }
+
+    //Build the index over the sets added
+    void Itv::build()
+    {
+        //Sort the valid sets by their minimum
+        std::vector<Id> order;
+        order.reserve(pending.size());
+        for (Id id=0;id<pending.size();id++)
+            if (pending[id].valid())
+                order.push_back(id);
+        std::sort(order.begin(),order.end(),[this](Id a, Id b)
+        {
+            return pending[a].get_min()<pending[b].get_min();
+        });
+
+        //Columns
+        std::size_t n=order.size();
+        mins.resize(n);
+        maxs.resize(n);
+        sub_max.resize(n);
+        ids=order;
+        for (std::size_t i=0;i<n;i++)
+        {
+            mins[i]=pending[ids[i]].get_min();
+            maxs[i]=pending[ids[i]].get_max();
+        }
+
+        //Augment the implicit tree
+        if (n)
+            build_node(0,n);
+    }
+
+    //Greatest maximum of the range [lo,hi), stored in its middle
+    Itv::Limit Itv::build_node (std::size_t lo, std::size_t hi)
+    {
+        std::size_t mid=lo+(hi-lo)/2;
+        Limit m=maxs[mid];
+        if (lo<mid)
+            m=std::max(m,build_node(lo,mid));
+        if (mid+1<hi)
+            m=std::max(m,build_node(mid+1,hi));
+        sub_max[mid]=m;
+        return m;
+    }
+
+    /* Queries */
+
+    //TTH of a set moving at the given speed against every set
+    void Itv::tth (const Set &s, Value speed, Set *out) const
+    {
+        for (std::size_t id=0;id<pending.size();id++)
+            out[id]=s.tth(pending[id],speed);
+    }
+
+}}//End of namespace
@@ -0,0 +1,282 @@
+/*
+ * FDX_Qry.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Qry
+    Batches of queries between shapes, run asynchronously on a pool of workers
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Qry.hpp"
+
+//Compounds
+#include "../include/FDX_Cmp.hpp"
+
+//Tracing
+#include "../include/FDX_Trc.hpp"
+
+//Groups
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <type_traits>
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Types of the shapes
+    */
+
+    //Call f with a null pointer of the class of a type of shape
+    template <class F>
+    static void with_class (Shp::Tag t, F f)
+    {
+        switch (t)
+        {
+            case Shp::Tag::crl: f(static_cast<const Crl*>(nullptr)); break;
+            case Shp::Tag::pnt: f(static_cast<const Pnt*>(nullptr)); break;
+            case Shp::Tag::rct: f(static_cast<const Rct*>(nullptr)); break;
+            case Shp::Tag::obb: f(static_cast<const Obb*>(nullptr)); break;
+            case Shp::Tag::pol: f(static_cast<const Pol*>(nullptr)); break;
+            case Shp::Tag::cap: f(static_cast<const Cap*>(nullptr)); break;
+            case Shp::Tag::cmp: f(static_cast<const Cmp*>(nullptr)); break;
+        }
+    }
+
+    //Group of a query, by its kind and the types of its shapes
+    static std::uint32_t group_key (Qry::Kind k, const Shp &a, const Shp &b)
+    {
+        return (static_cast<std::uint32_t>(k)<<16)|(static_cast<std::uint32_t>(a.get_tag())<<8)|static_cast<std::uint32_t>(b.get_tag());
+    }
+
+    /*
+        Batch of queries
+    */
+
+    //Greatest number of queries in a task
+    constexpr std::size_t Qry::CHUNK;
+
+    /* Queries */
+
+    //Add a query
+    std::size_t Qry::push (Kind k, const Shp &a, const Shp &b, const Vct &nspeed)
+    {
+        qa.push_back(&a);
+        qb.push_back(&b);
+        speed.push_back(nspeed);
+        kind.push_back(k);
+        return qa.size()-1;
+    }
+
+    //Remove every query
+    void Qry::clear()
+    {
+        qa.clear();
+        qb.clear();
+        speed.clear();
+        kind.clear();
+        res_contact.clear();
+        res_tth.clear();
+        res_toi.clear();
+        res_mov.clear();
+        order.clear();
+        tasks.clear();
+    }
+
+    /* Runs */
+
+    //Run every query on the calling thread
+    void Qry::run()
+    {
+        FDX_TRC_SPAN("query");
+        group();
+        for (std::size_t t=0;t+1<tasks.size();t++)
+            run_task(t);
+    }
+
+    //State of an asynchronous run, shared by its tasks
+    struct Qry_run
+    {
+        std::promise<void> done;//Future of the run
+        std::atomic<std::size_t> left;//Tasks not ended
+        std::atomic_flag failed=ATOMIC_FLAG_INIT;//A task has thrown
+        std::exception_ptr error;//Exception of the first task that threw
+
+        explicit Qry_run (std::size_t n) : left(n) {}
+    };
+
+    //Run the queries on a pool
+    std::future<void> Qry::run_async (Wrk &w)
+    {
+        group();
+        auto run=std::make_shared<Qry_run>(tasks.size()-1);
+        std::future<void> rv=run->done.get_future();
+        std::size_t n=tasks.size()-1;
+        if (!n)
+        {
+            run->done.set_value();
+            return rv;
+        }
+
+        //The last task to end sets the future, with the first exception if any task threw
+        for (std::size_t t=0;t<n;t++)
+            w.post([this,t,run]
+            {
+                try
+                {
+                    FDX_TRC_SPAN("query");
+                    run_task(t);
+                }
+                catch (...)
+                {
+                    if (!run->failed.test_and_set(std::memory_order_relaxed))
+                        run->error=std::current_exception();
+                }
+                if (run->left.fetch_sub(1,std::memory_order_acq_rel)==1)
+                {
+                    if (run->error)
+                        run->done.set_exception(run->error);
+                    else
+                        run->done.set_value();
+                }
+            });
+        return rv;
+    }
+
+    //Group the queries and split the groups in tasks
+    void Qry::group()
+    {
+        std::size_t n=size();
+        res_contact.resize(n);
+        res_tth.resize(n);
+        res_toi.resize(n);
+        res_mov.resize(n);
+
+        //Order by group
+        std::vector<std::uint32_t> key(n);
+        order.resize(n);
+        for (std::size_t i=0;i<n;i++)
+        {
+            key[i]=group_key(kind[i],*qa[i],*qb[i]);
+            order[i]=static_cast<std::uint32_t>(i);
+        }
+        std::stable_sort(order.begin(),order.end(),[&key](std::uint32_t i, std::uint32_t j)
+        {
+            return key[i]<key[j];
+        });
+
+        //A task never mixes groups
+        tasks.clear();
+        for (std::size_t i=0;i<n;i++)
+            if (tasks.empty()||i==tasks.back()+CHUNK||key[order[i]]!=key[order[i-1]])
+                tasks.push_back(static_cast<std::uint32_t>(i));
+        tasks.push_back(static_cast<std::uint32_t>(n));
+    }
+
+    /*Run the queries at the given indices, the calls are not virtual
+      The results are the same as calling the query through Shp: the generic versions of the simple shapes
+      call the version of the second shape for the first one (reversed speed), compounds solve it themselves*/
+    template <class A, class B>
+    void Qry::kernel (Kind k, const std::uint32_t *idx, std::size_t n)
+    {
+        switch (k)
+        {
+            case Kind::contact:
+                for (std::size_t i=0;i<n;i++)
+                {
+                    std::uint32_t q=idx[i];
+                    const A &a=static_cast<const A&>(*qa[q]);
+                    const B &b=static_cast<const B&>(*qb[q]);
+                    if constexpr (std::is_same_v<A,Cmp>)
+                        res_contact[q]=a.Cmp::contact(static_cast<const Shp&>(b));
+                    else
+                        res_contact[q]=b.B::contact(a);
+                }
+                break;
+            case Kind::tth:
+                for (std::size_t i=0;i<n;i++)
+                {
+                    std::uint32_t q=idx[i];
+                    const A &a=static_cast<const A&>(*qa[q]);
+                    const B &b=static_cast<const B&>(*qb[q]);
+                    if constexpr (std::is_same_v<A,Cmp>)
+                        res_tth[q]=a.Cmp::tth(static_cast<const Shp&>(b),speed[q]);
+                    else
+                        res_tth[q]=b.B::tth(a,-speed[q]);
+                }
+                break;
+            case Kind::toi:
+                for (std::size_t i=0;i<n;i++)
+                {
+                    std::uint32_t q=idx[i];
+                    const A &a=static_cast<const A&>(*qa[q]);
+                    const B &b=static_cast<const B&>(*qb[q]);
+                    if constexpr (std::is_same_v<A,Cmp>)
+                        res_toi[q]=a.Cmp::toi(static_cast<const Shp&>(b),speed[q]);
+                    else
+                        res_toi[q]=flip_toi(b.B::toi(a,-speed[q]),speed[q]);
+                }
+                break;
+            case Kind::mov_against:
+                for (std::size_t i=0;i<n;i++)
+                {
+                    std::uint32_t q=idx[i];
+                    const A &a=static_cast<const A&>(*qa[q]);
+                    const B &b=static_cast<const B&>(*qb[q]);
+                    if constexpr (std::is_same_v<A,Cmp>)
+                        res_mov[q]=a.Cmp::mov_against(static_cast<const Shp&>(b),speed[q]);
+                    else
+                        res_mov[q]=-b.B::mov_against(a,-speed[q]);
+                }
+                break;
+        }
+    }
+
+    //Run the task t
+    void Qry::run_task (std::size_t t)
+    {
+        const std::uint32_t *idx=order.data()+tasks[t];
+        std::size_t n=tasks[t+1]-tasks[t];
+        std::uint32_t q=idx[0];
+        with_class(qa[q]->get_tag(),[&](auto pa)
+        {
+            with_class(qb[q]->get_tag(),[&](auto pb)
+            {
+                kernel<std::remove_cv_t<std::remove_pointer_t<decltype(pa)>>,std::remove_cv_t<std::remove_pointer_t<decltype(pb)>>>(kind[q],idx,n);
+            });
+        });
+    }
+
+}}//End of namespace
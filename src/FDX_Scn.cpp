@@ -0,0 +1,359 @@
+/*
+ * FDX_Scn.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Scn
+    Scene of shapes and queries over its bounding volume hierarchy
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Scn.hpp"
+
+//Tracing of the phases
+#include "../include/FDX_Trc.hpp"
+
+//Maximum and minimum, heaps
+#include <algorithm>
+
+//Pairs of distance and node or shape
+#include <utility>
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Scene
+    */
+
+    constexpr std::size_t Scn::PACKET;
+
+    /* Hierarchy */
+
+    //Build the hierarchy over the shapes
+    void Scn::build()
+    {
+        FDX_TRC_SPAN("broadphase");
+        boxes.resize(shapes.size());
+        for (std::size_t i=0;i<shapes.size();i++)
+            boxes[i]=shapes[i]->get_bounds();
+        bvh.build(boxes);
+    }
+
+    //Update the hierarchy after the shapes moved or changed their size
+    void Scn::refit()
+    {
+        FDX_TRC_SPAN("broadphase");
+        if (boxes.size()!=shapes.size())//New shapes, build again
+        {
+            build();
+            return;
+        }
+        for (std::size_t i=0;i<shapes.size();i++)
+            boxes[i]=shapes[i]->get_bounds();
+        bvh.refit(boxes);
+    }
+
+    /* Ray casts */
+
+    //Cast n rays
+    void Scn::raycast (const Ray *rays, std::size_t n, Ray_hit *hits) const
+    {
+        FDX_TRC_SPAN("raycast");
+        for (std::size_t i=0;i<n;i+=PACKET)
+            raycast_packet(rays+i,std::min(PACKET,n-i),hits+i);
+    }
+
+    //Cast a packet of at most PACKET rays
+    void Scn::raycast_packet (const Ray *rays, std::size_t n, Ray_hit *hits) const
+    {
+        //Rays of the packet in columns, the speed covers the whole ray in a tick
+        Vct::Coord ox[PACKET], oy[PACKET], ix[PACKET], iy[PACKET], best[PACKET];
+        Vct speed[PACKET];
+        for (std::size_t k=0;k<n;k++)
+        {
+            speed[k]=rays[k].dir;
+            speed[k].limmod(rays[k].max_len);
+            ox[k]=rays[k].origin.x;
+            oy[k]=rays[k].origin.y;
+            ix[k]=1/speed[k].x;
+            iy[k]=1/speed[k].y;
+            best[k]=2;//Any hit is in [0,1]
+            hits[k].shape=NO_SHP;
+            hits[k].t=-1;
+        }
+        //Unused lanes never hit a box
+        for (std::size_t k=n;k<PACKET;k++)
+        {
+            ox[k]=oy[k]=ix[k]=iy[k]=0;
+            best[k]=-1;
+        }
+
+        if (bvh.empty())
+            return;
+
+        //Traverse the hierarchy once for the whole packet
+        std::uint32_t stack[64];
+        int top=0;
+        stack[top++]=0;
+        while (top)
+        {
+            const Bvh::Node &node=bvh.node(stack[--top]);
+
+            //Slab test of every ray against the box of the node
+            //(NaN from rays parallel to a side are ignored by the min/max, the test stays conservative)
+            Vct::Coord
+                minx=node.box.x.get_min(), maxx=node.box.x.get_max(),
+                miny=node.box.y.get_min(), maxy=node.box.y.get_max();
+            bool active[PACKET];
+            bool any=false;
+            for (std::size_t k=0;k<PACKET;k++)
+            {
+                Vct::Coord
+                    tx1=(minx-ox[k])*ix[k], tx2=(maxx-ox[k])*ix[k],
+                    ty1=(miny-oy[k])*iy[k], ty2=(maxy-oy[k])*iy[k];
+                Vct::Coord tmin=std::max(std::max(0.0,std::min(tx1,tx2)),std::min(ty1,ty2));
+                Vct::Coord tmax=std::min(std::min(best[k],std::max(tx1,tx2)),std::max(ty1,ty2));
+                active[k]=tmin<=tmax;
+                any|=active[k];
+            }
+            if (!any)
+                continue;
+
+            if (node.leaf())
+            {
+                //Exact time to hit of the active rays against the shapes of the leaf
+                for (std::uint32_t i=node.first;i<node.first+node.count;i++)
+                {
+                    Scn_hdl h=bvh.item(i);
+                    const Shp &s=*shapes[h];
+                    for (std::size_t k=0;k<n;k++)
+                    {
+                        if (!active[k])
+                            continue;
+                        Toi toi=Pnt(rays[k].origin).toi(s,speed[k]);
+                        if (toi.t>=0&&toi.t<=1&&toi.t<best[k])
+                        {
+                            best[k]=toi.t;
+                            hits[k].shape=h;
+                            hits[k].t=toi.t;
+                            hits[k].normal=toi.normal;
+                        }
+                    }
+                }
+            }
+            else
+            {
+                stack[top++]=node.first+1;
+                stack[top++]=node.first;
+            }
+        }
+    }
+
+    /* Shape casts */
+
+    //Sweep a shape at the given speed for a tick, returns the first shape of the scene hit
+    Ray_hit Scn::shapecast (const Shp &s, const Vct &speed, Scn_hdl ignore) const
+    {
+
+        Ray_hit hit;
+        hit.shape=NO_SHP;
+        hit.t=-1;
+        if (bvh.empty())
+            return hit;
+
+        Box sb(s);
+        Vct::Mod best=1;//Hits must be in [0,best)
+
+        //Nodes to visit with the time at which the shape enters their box
+        struct Entry
+        {
+            std::uint32_t n;
+            Vct::Mod t;
+        };
+        Entry stack[64];
+        int top=0;
+
+        //Time at which the box of the shape enters a box, negative if never in this tick
+        auto enter=[&sb,&speed](const Box &b)->Vct::Mod
+        {
+            Set ttc(sb.tth(b,speed));
+            if (!ttc.valid()||ttc.get_max()<0||ttc.get_min()>=1)
+                return -1;
+            return std::max(0.0,ttc.get_min());
+        };
+
+        Vct::Mod troot=enter(bvh.node(0).box);
+        if (troot>=0)
+            stack[top++]=Entry{0,troot};
+
+        while (top)
+        {
+            Entry e=stack[--top];
+
+            //Prune the nodes that can't beat the best hit
+            if (e.t>=best)
+                continue;
+
+            const Bvh::Node &node=bvh.node(e.n);
+            if (node.leaf())
+            {
+                for (std::uint32_t i=node.first;i<node.first+node.count;i++)
+                {
+                    Scn_hdl h=bvh.item(i);
+                    if (h==ignore)
+                        continue;
+                    Toi toi=s.toi(*shapes[h],speed);
+                    if (toi.t>=0&&toi.t<best)
+                    {
+                        best=toi.t;
+                        hit.shape=h;
+                        hit.t=toi.t;
+                        hit.normal=toi.normal;
+                    }
+                }
+            }
+            else
+            {
+                //Visit the closest child first (pushed last)
+                Vct::Mod
+                    tl=enter(bvh.node(node.first).box),
+                    tr=enter(bvh.node(node.first+1).box);
+                Entry l{node.first,tl}, r{node.first+1,tr};
+                if (tl>tr)
+                    std::swap(l,r);
+                if (r.t>=0&&r.t<best)
+                    stack[top++]=r;
+                if (l.t>=0&&l.t<best)
+                    stack[top++]=l;
+            }
+        }
+        return hit;
+    }
+
+    /* Overlap queries */
+
+    //Write the handles of the shapes in contact with the given shape, stops when cap handles are written
+    std::size_t Scn::overlap (const Shp &s, Scn_hdl *out, std::size_t cap) const
+    {
+        std::size_t n=0;
+        if (!cap)
+            return 0;
+        overlap(s,[out,cap,&n](Scn_hdl h)
+        {
+            out[n++]=h;
+            return n<cap;
+        });
+        return n;
+    }
+
+    /* Nearest shapes */
+
+    //Write the k shapes closest to a point in out, closest first
+    std::size_t Scn::knn (const Vct &p, std::size_t k, Scn_hdl *out, Vct::Mod *sq_dists, Vct::Mod max_sq) const
+    {
+        if (!k||bvh.empty())
+            return 0;
+
+        typedef std::pair<Vct::Mod,std::uint32_t> Entry;//Squared distance and node or shape
+
+        //Scratch storage of the thread, reused between queries
+        static thread_local std::vector<Entry> queue, best;
+        queue.clear();
+        best.clear();
+
+        //Bound of the distance of the results, the k-th best distance once there are k results
+        Vct::Mod bound=max_sq;
+
+        //Best-first traversal, the queue is a min heap by the distance to the box of the node
+        auto closer=[](const Entry &a, const Entry &b){return a.first>b.first;};
+        queue.push_back(Entry(bvh.node(0).box.sq_dist(p),0));
+        while (!queue.empty())
+        {
+            std::pop_heap(queue.begin(),queue.end(),closer);
+            Entry e=queue.back();
+            queue.pop_back();
+
+            //No node left can improve the results
+            if (e.first>bound)
+                break;
+
+            const Bvh::Node &node=bvh.node(e.second);
+            if (node.leaf())
+            {
+                for (std::uint32_t i=node.first;i<node.first+node.count;i++)
+                {
+                    std::uint32_t h=bvh.item(i);
+                    if (boxes[h].sq_dist(p)>bound)
+                        continue;
+                    Vct::Mod d=shapes[h]->sq_dist(p);
+                    if (d>bound)
+                        continue;
+
+                    //Keep the k best in a max heap
+                    best.push_back(Entry(d,h));
+                    std::push_heap(best.begin(),best.end());
+                    if (best.size()>k)
+                    {
+                        std::pop_heap(best.begin(),best.end());
+                        best.pop_back();
+                    }
+                    if (best.size()==k)
+                        bound=best.front().first;
+                }
+            }
+            else
+            {
+                for (std::uint32_t c=node.first;c<node.first+2;c++)
+                {
+                    Vct::Mod d=bvh.node(c).box.sq_dist(p);
+                    if (d<=bound)
+                    {
+                        queue.push_back(Entry(d,c));
+                        std::push_heap(queue.begin(),queue.end(),closer);
+                    }
+                }
+            }
+        }
+
+        //Closest first
+        std::sort_heap(best.begin(),best.end());
+        for (std::size_t i=0;i<best.size();i++)
+        {
+            out[i]=best[i].second;
+            if (sq_dists)
+                sq_dists[i]=best[i].first;
+        }
+        return best.size();
+    }
+
+}}//End of namespace
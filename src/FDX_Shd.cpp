@@ -0,0 +1,378 @@
+/*
+ * FDX_Shd.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Shd
+    Shards of the world simulated by processes, with halos exchanged through shared memory
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Shd.hpp"
+
+//Tracing
+#include "../include/FDX_Trc.hpp"
+
+//Cells of the points
+#include <cmath>
+
+//Regions of the border
+#include <limits>
+
+//Waiting for the neighbours
+#include <chrono>
+#include <thread>
+
+//Shared memory
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <cerrno>
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Map
+    */
+
+    //Shard whose region has the point
+    std::uint32_t Shd_map::shard (const Vct &p) const
+    {
+        Vct d=world.get_diagonal(), m=world.get_min();
+        Vct::Coord fx=std::floor((p.x-m.x)*nx/d.x), fy=std::floor((p.y-m.y)*ny/d.y);
+        std::uint32_t cx=fx<0?0:(fx>=nx?nx-1:static_cast<std::uint32_t>(fx));
+        std::uint32_t cy=fy<0?0:(fy>=ny?ny-1:static_cast<std::uint32_t>(fy));
+        return cy*nx+cx;
+    }
+
+    //Region of a shard
+    Box Shd_map::region (std::uint32_t id) const
+    {
+        Vct d=world.get_diagonal(), m=world.get_min();
+        std::uint32_t cx=id%nx, cy=id/nx;
+        Vct::Coord inf=std::numeric_limits<Vct::Coord>::infinity();
+        Vct::Coord x0=cx?m.x+d.x*cx/nx:-inf, x1=cx+1<nx?m.x+d.x*(cx+1)/nx:inf;
+        Vct::Coord y0=cy?m.y+d.y*cy/ny:-inf, y1=cy+1<ny?m.y+d.y*(cy+1)/ny:inf;
+        return Box(Set(x0,x1),Set(y0,y1));
+    }
+
+    //Check if two different shards are neighbours (their cells touch)
+    bool Shd_map::neighbours (std::uint32_t a, std::uint32_t b) const
+    {
+        if (a==b||a>=count()||b>=count())
+            return false;
+        std::int64_t dx=std::int64_t(a%nx)-std::int64_t(b%nx), dy=std::int64_t(a/nx)-std::int64_t(b/nx);
+        return dx>=-1&&dx<=1&&dy>=-1&&dy<=1;
+    }
+
+    //Neighbour of the shard a on the way to the shard b
+    std::uint32_t Shd_map::toward (std::uint32_t a, std::uint32_t b) const
+    {
+        std::uint32_t ax=a%nx, ay=a/nx, bx=b%nx, by=b/nx;
+        if (ax!=bx)
+            ax=ax<bx?ax+1:ax-1;
+        if (ay!=by)
+            ay=ay<by?ay+1:ay-1;
+        return ay*nx+ax;
+    }
+
+    /*
+        Shard
+    */
+
+    /* Constructors, copy control */
+
+    //Create the segment of a shard
+    Shd::Shd (const Shd_map &nmap, std::uint32_t nid, const std::string &nprefix, std::uint64_t nrun, std::uint32_t ncapacity)
+    :map(nmap), id(nid), prefix(nprefix), run(nrun), capacity(ncapacity), seg(nullptr), tick(0), timeout(10), written(false), fit(true), forwarded(0)
+    {
+        //Names of shared memory start by a slash
+        if (prefix.empty()||prefix[0]!='/')
+            prefix.insert(prefix.begin(),'/');
+
+        for (std::uint32_t s=0;s<map.count();s++)
+            if (map.neighbours(id,s))
+                near.push_back(s);
+        segs.assign(near.size(),nullptr);
+
+        //Remove the segment left by an old run, the neighbours must not open it before it's created again
+        std::string n=name(id);
+        shm_unlink(n.c_str());
+        int fd=shm_open(n.c_str(),O_CREAT|O_EXCL|O_RDWR,0600);
+        if (fd<0)
+            return;
+        void *p=MAP_FAILED;
+        if (ftruncate(fd,bytes())==0)//Zero filled: tick 0, not ready
+            p=mmap(nullptr,bytes(),PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+        close(fd);
+        if (p==MAP_FAILED)
+        {
+            shm_unlink(n.c_str());
+            return;
+        }
+        seg=static_cast<Seg*>(p);
+        seg->capacity=capacity;
+        seg->run=run;
+        seg->ready.store(1,std::memory_order_release);
+    }
+
+    //Destructor, unmaps the segments and removes the own one
+    Shd::~Shd()
+    {
+        for (Seg *s : segs)
+            if (s)
+                munmap(s,bytes());
+        if (seg)
+        {
+            munmap(seg,bytes());
+            shm_unlink(name(id).c_str());
+        }
+    }
+
+    /* Bodies */
+
+    //Add a body owned by the shard with a global id
+    Bdy_hdl Shd::add (std::uint64_t gid, const Shp &s, const Vct &speed)
+    {
+        Bdy_hdl h=own.add(s,speed);
+        if (gids.size()<=h.index)
+            gids.resize(h.index+1);
+        gids[h.index]=gid;
+        return h;
+    }
+
+    /* Exchange */
+
+    //Exchange the records of a tick with the neighbours
+    bool Shd::exchange()
+    {
+        FDX_TRC_SPAN("exchange");
+
+        if (!seg)
+            return false;
+        for (std::size_t k=0;k<near.size();k++)
+            if (!segs[k]&&!(segs[k]=open(near[k])))
+                return false;
+
+        //The buffer of the next tick is free once every neighbour wrote this one (they read the one before it)
+        if (!written)
+        {
+            if (!wait(tick))
+                return false;
+            tick++;
+            fit=write();
+            seg->tick.store(tick,std::memory_order_release);
+            written=true;
+        }
+
+        //Read the records of the neighbours once they are written
+        if (!wait(tick))
+            return false;
+        written=false;
+        read();
+
+        //Owned bodies and copies changed, build the hierarchy again
+        boxes.resize(own.size()+halo.size());
+        own.bounds(0,own.size(),boxes.data());
+        halo.bounds(0,halo.size(),boxes.data()+own.size());
+        bvh.build(boxes);
+        return fit;
+    }
+
+    //Update the boxes of the hierarchy after moving the owned bodies
+    void Shd::refit()
+    {
+        if (boxes.size()!=own.size()+halo.size())//Bodies added or removed, build again
+        {
+            boxes.resize(own.size()+halo.size());
+            own.bounds(0,own.size(),boxes.data());
+            halo.bounds(0,halo.size(),boxes.data()+own.size());
+            bvh.build(boxes);
+            return;
+        }
+        own.bounds(0,own.size(),boxes.data());
+        bvh.refit(boxes);
+    }
+
+    //Name of the segment of a shard
+    std::string Shd::name (std::uint32_t s) const
+    {
+        return prefix+"_"+std::to_string(s);
+    }
+
+    //Size of a segment
+    std::size_t Shd::bytes() const
+    {
+        return sizeof(Seg)+2*std::size_t(capacity)*sizeof(Shd_rec);
+    }
+
+    /*Map the segment of a neighbour, waits until it's created by the shard of this run
+      Segments not initialized yet, of another size or left by other runs are opened again until they are replaced*/
+    Shd::Seg* Shd::open (std::uint32_t s) const
+    {
+        std::string n=name(s);
+        auto end=std::chrono::steady_clock::now()+std::chrono::duration<Vct::Mod>(timeout);
+        while (std::chrono::steady_clock::now()<end)
+        {
+            int fd=shm_open(n.c_str(),O_RDWR,0600);
+            if (fd<0&&errno!=ENOENT)
+                return nullptr;
+            if (fd>=0)
+            {
+                //The size is set after the creation
+                struct stat st;
+                void *p=MAP_FAILED;
+                if (fstat(fd,&st)==0&&std::size_t(st.st_size)>=bytes())
+                    p=mmap(nullptr,bytes(),PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+                close(fd);
+                if (p!=MAP_FAILED)
+                {
+                    Seg *g=static_cast<Seg*>(p);
+                    if (g->ready.load(std::memory_order_acquire)&&g->run==run)
+                    {
+                        //Every shard must have the same capacity
+                        if (g->capacity==capacity)
+                            return g;
+                        munmap(p,bytes());
+                        return nullptr;
+                    }
+                    munmap(p,bytes());
+                }
+            }
+            std::this_thread::yield();
+        }
+        return nullptr;
+    }
+
+    //Wait until every neighbour wrote the tick t
+    bool Shd::wait (std::uint64_t t) const
+    {
+        auto end=std::chrono::steady_clock::now()+std::chrono::duration<Vct::Mod>(timeout);
+        for (Seg *s : segs)
+            while (s->tick.load(std::memory_order_acquire)<t)
+            {
+                if (std::chrono::steady_clock::now()>=end)
+                    return false;
+                std::this_thread::yield();
+            }
+        return true;
+    }
+
+    //Write the records of the tick
+    bool Shd::write()
+    {
+        Box r=map.region(id);
+        Vct::Mod w=map.get_halo();
+        Vct lo=r.get_min()+Vct(w,w), hi=r.get_max()-Vct(w,w);
+
+        Shd_rec *recs=seg->records(tick);
+        std::uint32_t count=0;
+        bool fit=true;
+        forwarded=0;
+        const Bdy_store &st=own;
+        const Vct::Coord *x=st.pos_x(), *y=st.pos_y(), *hx=st.ext_x(), *hy=st.ext_y();
+        const Vct::Coord *ax=st.axis_x(), *ay=st.axis_y(), *vx=st.speed_x(), *vy=st.speed_y();
+        const Shp::Tag *t=st.tags();
+
+        //Backwards, removing a body moves the last one to its dense index
+        for (std::size_t i=own.size();i-->0;)
+        {
+            //Bodies that left the region migrate to a neighbour (on the way to their region), the rest are copied if they are near the border
+            std::uint32_t dest=map.shard(Vct(x[i],y[i]));
+            bool skip=dest!=id&&!map.neighbours(id,dest);
+            if (skip)
+                dest=map.toward(id,dest);
+            if (dest==id)
+            {
+                Box b=Bdy_store::bounds(t[i],x[i],y[i],hx[i],hy[i],ax[i],ay[i]);
+                Vct bmin=b.get_min(), bmax=b.get_max();
+                if (bmin.x>=lo.x&&bmin.y>=lo.y&&bmax.x<=hi.x&&bmax.y<=hi.y)
+                    continue;
+                dest=NO_SHARD;
+            }
+            if (count==capacity)
+            {
+                fit=false;
+                continue;
+            }
+            Bdy_hdl h=own.handle(i);
+            recs[count++]={gids[h.index],x[i],y[i],hx[i],hy[i],ax[i],ay[i],vx[i],vy[i],dest,t[i]};
+            if (dest!=NO_SHARD)
+                own.remove(h);
+            forwarded+=skip;
+        }
+        seg->count[tick%2]=count;
+        return fit;
+    }
+
+    //Read the records of the neighbours for the tick
+    void Shd::read()
+    {
+        Box r=map.region(id);
+        Vct::Mod w=map.get_halo();
+        Box g(Set(r.get_min().x-w,r.get_max().x+w),Set(r.get_min().y-w,r.get_max().y+w));
+
+        /*The bodies that migrated from the shard are copied back if they are near,
+          they are not copied by their new owner until the next tick*/
+        halo.clear();
+        halo_gids.clear();
+        for (std::size_t j=0;j<=segs.size();j++)
+        {
+            Seg *s=j<segs.size()?segs[j]:seg;
+            const Shd_rec *recs=s->records(tick);
+            for (std::uint32_t k=0,n=s->count[tick%2];k<n;k++)
+            {
+                const Shd_rec &c=recs[k];
+                if (s==seg&&c.dest==NO_SHARD)//Owned body
+                    continue;
+                Vct p(c.x,c.y), e(c.hx,c.hy), a(c.ax,c.ay), v(c.vx,c.vy);
+                if (c.dest==id)//Takes the body
+                {
+                    Bdy_hdl h=own.add(c.tag,p,e,a,v);
+                    if (gids.size()<=h.index)
+                        gids.resize(h.index+1);
+                    gids[h.index]=c.gid;
+                }
+                else if (Bdy_store::bounds(c.tag,c.x,c.y,c.hx,c.hy,c.ax,c.ay).overlap(g))//Copy near the region
+                {
+                    halo.add(c.tag,p,e,a,v);
+                    halo_gids.push_back(c.gid);
+                }
+            }
+        }
+    }
+
+}}//End of namespace
+
+//End of library
@@ -0,0 +1,287 @@
+/*
+ * FDX_Sol.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Sol
+    Batched response of the contacts with impulses
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Sol.hpp"
+
+//Tracing
+#include "../include/FDX_Trc.hpp"
+
+//Limits of the impulses
+#include <algorithm>
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Solver of contacts
+    */
+
+    /* Depth of the contacts */
+
+    //Distance from the center of a body to its farthest point along a unitary direction
+    static Vct::Mod reach (const Bdy_store &s, std::uint32_t i, const Vct &n)
+    {
+        Vct::Coord ex=s.ext_x()[i], ey=s.ext_y()[i], ux=s.axis_x()[i], uy=s.axis_y()[i];
+        Vct::Mod along=std::abs(n.x*ux+n.y*uy), across=std::abs(n.y*ux-n.x*uy);//Projections on the axes of the body
+        switch (s.tags()[i])
+        {
+            case Shp::Tag::crl:
+                return ex;
+            case Shp::Tag::pnt:
+                return 0;
+            case Shp::Tag::cap://Segment of half length ex rounded by ey
+                return along*ex+ey;
+            default://Rectangles, along their axes
+                return along*ex+across*ey;
+        }
+    }
+
+    /* Contacts */
+
+    //Add a contact between two bodies given by their dense indices
+    void Sol::add (std::uint32_t a, std::uint32_t b, const Vct &normal, Mod t, Mod ndepth)
+    {
+        ca.push_back(a);
+        cb.push_back(b);
+        nx.push_back(normal.x);
+        ny.push_back(normal.y);
+        t0.push_back(t);
+        depth.push_back(ndepth);
+    }
+
+    //Add the contacts of n pairs of bodies of a store given by their dense indices
+    std::size_t Sol::add (const Bdy_store &s, const std::uint32_t *a, const std::uint32_t *b, std::size_t n, Mod dt)
+    {
+        FDX_TRC_SPAN("narrowphase");
+        std::size_t added=0;
+        Shp_buf ba,bb;
+        const Vca &spd=s.speeds();
+        for (std::size_t k=0;k<n;k++)
+        {
+            //The first body moves against the second during the step
+            Toi toi=s.shape(a[k],ba).toi(s.shape(b[k],bb),(spd.get(a[k])-spd.get(b[k]))*dt);
+            if (toi.t<0||toi.t>1)
+                continue;
+
+            //Overlap of bodies already in contact
+            Mod d=0;
+            if (toi.t==0)
+            {
+                Box xa(s.bounds(a[k])), xb(s.bounds(b[k]));
+                Vct c(xa.get_center()-xb.get_center()), h(Vct(xa.get_diagonal()+xb.get_diagonal(),0.5));
+
+                //The normal of a shape inside a rectangle only gives the directions, take the axis with less overlap
+                if (toi.feature==Toi::Feature::center)
+                {
+                    Mod ox=h.x-std::abs(c.x), oy=h.y-std::abs(c.y);
+                    toi.normal=ox<oy?Vct(c.x<0?-1:1,0):Vct(0,c.y<0?-1:1);
+                }
+
+                //Circles and points, the exact overlap of their radii
+                const Shp::Tag *tag=s.tags();
+                bool round_a=tag[a[k]]==Shp::Tag::crl||tag[a[k]]==Shp::Tag::pnt, round_b=tag[b[k]]==Shp::Tag::crl||tag[b[k]]==Shp::Tag::pnt;
+                if (round_a&&round_b)
+                    d=s.ext_x()[a[k]]+s.ext_x()[b[k]]-c.mod();
+                else//Both bodies projected on the normal (a round TOI may be the end of a capsule, whose box isn't centered on the contact)
+                    d=reach(s,a[k],toi.normal)+reach(s,b[k],toi.normal)-(c.x*toi.normal.x+c.y*toi.normal.y);
+            }
+
+            add(a[k],b[k],toi.normal,toi.t,std::max<Mod>(d,0));
+            added++;
+        }
+        return added;
+    }
+
+    //Remove every contact
+    void Sol::clear()
+    {
+        ca.clear();
+        cb.clear();
+        nx.clear();
+        ny.clear();
+        t0.clear();
+        depth.clear();
+        mass.clear();
+        target.clear();
+        jn.clear();
+        jt.clear();
+        djn.clear();
+        djt.clear();
+        weight.clear();
+        count.clear();
+    }
+
+    /* Solver */
+
+    //Change the speeds of the bodies with the impulses of the contacts
+    void Sol::solve (Vca &spd, const Mod *inv_mass, Mod dt)
+    {
+        FDX_TRC_SPAN("solve");
+        prepare(spd,inv_mass,dt);
+        for (unsigned i=0;i<iterations;i++)
+        {
+            if (iteration==Iteration::sequential)
+                iterate_sequential(spd,inv_mass);
+            else
+                iterate_jacobi(spd,inv_mass);
+        }
+    }
+
+    //Compute the mass and the target speed of every contact, the impulses start at 0
+    void Sol::prepare (const Vca &spd, const Mod *inv_mass, Mod dt)
+    {
+        std::size_t n=size();
+        mass.resize(n);
+        target.resize(n);
+        jn.assign(n,0);
+        jt.assign(n,0);
+
+        const Coord *vx=spd.x.data(), *vy=spd.y.data();
+        for (std::size_t k=0;k<n;k++)
+        {
+            std::uint32_t a=ca[k], b=cb[k];
+            Mod im=inv_mass[a]+inv_mass[b];
+            mass[k]=im>0?1/im:0;
+
+            /*Normal speed before the step (negative if the bodies approach)
+              Speculative: they can approach until they touch, the part of the step before the contact*/
+            Mod vn=(vx[a]-vx[b])*nx[k]+(vy[a]-vy[b])*ny[k];
+            Mod tg=std::min<Mod>(vn,0)*t0[k];
+
+            /*Restitution: fast enough impacts bounce, only once the bodies touch
+              (a speculative contact would bounce off the empty space before the surface)*/
+            if (t0[k]==0&&-vn>rest_speed)
+                tg=std::max(tg,-restitution*vn);
+
+            //Overlapping bodies separate
+            target[k]=tg+push*depth[k]/dt;
+        }
+
+        //Jacobi: the impulse of each contact is shared between the contacts of its busiest body
+        if (iteration==Iteration::jacobi)
+        {
+            djn.resize(n);
+            djt.resize(n);
+            weight.resize(n);
+            count.assign(spd.size(),0);
+            for (std::size_t k=0;k<n;k++)
+            {
+                count[ca[k]]++;
+                count[cb[k]]++;
+            }
+            for (std::size_t k=0;k<n;k++)
+                weight[k]=Mod(1)/std::max(count[ca[k]],count[cb[k]]);
+        }
+    }
+
+    //Iteration with sequential impulses
+    void Sol::iterate_sequential (Vca &spd, const Mod *inv_mass)
+    {
+        std::size_t n=size();
+        Coord *vx=spd.x.data(), *vy=spd.y.data();
+        for (std::size_t k=0;k<n;k++)
+        {
+            std::uint32_t a=ca[k], b=cb[k];
+            Coord ux=nx[k], uy=ny[k];
+            Mod ia=inv_mass[a], ib=inv_mass[b];
+
+            //Normal impulse, the accumulated one can only push
+            Mod vn=(vx[a]-vx[b])*ux+(vy[a]-vy[b])*uy;
+            Mod j=std::max<Mod>(jn[k]+mass[k]*(target[k]-vn),0);
+            Mod d=j-jn[k];
+            jn[k]=j;
+            vx[a]+=ux*d*ia;
+            vy[a]+=uy*d*ia;
+            vx[b]-=ux*d*ib;
+            vy[b]-=uy*d*ib;
+
+            //Tangent impulse (tangent is the normal rotated PI/2), limited by the normal one
+            Mod vt=-(vx[a]-vx[b])*uy+(vy[a]-vy[b])*ux;
+            Mod lim=friction*jn[k];
+            j=std::min(std::max(jt[k]-mass[k]*vt,-lim),lim);
+            d=j-jt[k];
+            jt[k]=j;
+            vx[a]-=uy*d*ia;
+            vy[a]+=ux*d*ia;
+            vx[b]+=uy*d*ib;
+            vy[b]-=ux*d*ib;
+        }
+    }
+
+    //Iteration of Jacobi
+    void Sol::iterate_jacobi (Vca &spd, const Mod *inv_mass)
+    {
+        std::size_t n=size();
+        Coord *vx=spd.x.data(), *vy=spd.y.data();
+
+        //Impulses with the speeds of the last iteration
+        for (std::size_t k=0;k<n;k++)
+        {
+            std::uint32_t a=ca[k], b=cb[k];
+            Coord ux=nx[k], uy=ny[k];
+            Coord rx=vx[a]-vx[b], ry=vy[a]-vy[b];
+            Mod w=weight[k];
+
+            Mod vn=rx*ux+ry*uy;
+            Mod j=std::max<Mod>(jn[k]+w*mass[k]*(target[k]-vn),0);
+            djn[k]=j-jn[k];
+            jn[k]=j;
+
+            //Friction, the normal impulse doesn't change the tangent speed
+            Mod vt=-rx*uy+ry*ux;
+            Mod lim=friction*jn[k];
+            j=std::min(std::max(jt[k]-w*mass[k]*vt,-lim),lim);
+            djt[k]=j-jt[k];
+            jt[k]=j;
+        }
+
+        //Apply them together
+        for (std::size_t k=0;k<n;k++)
+        {
+            std::uint32_t a=ca[k], b=cb[k];
+            Coord ux=nx[k], uy=ny[k];
+            Coord ix=ux*djn[k]-uy*djt[k], iy=uy*djn[k]+ux*djt[k];
+            vx[a]+=ix*inv_mass[a];
+            vy[a]+=iy*inv_mass[a];
+            vx[b]-=ix*inv_mass[b];
+            vy[b]-=iy*inv_mass[b];
+        }
+    }
+
+}}//End of namespace
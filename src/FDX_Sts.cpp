@@ -0,0 +1,172 @@
+/*
+ * FDX_Sts.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Sts
+    Hot path statistics (counters compiled only with FDX_ARROW_STATS)
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Sts.hpp"
+
+//Registry of the threads
+#include <mutex>
+#include <vector>
+#include <algorithm>
+
+namespace fdx{ namespace arrow { namespace sts
+{
+    /*
+        Registry
+    */
+
+    namespace
+    {
+        //Counters of the live threads and totals of the finished ones
+        struct Registry
+        {
+            std::mutex m;
+            std::vector<Local*> live;
+            Stats retired{};
+        };
+
+        //Registry (never destroyed, threads may finish after the static destructors)
+        Registry& registry()
+        {
+            static Registry *r=new Registry;
+            return *r;
+        }
+    }
+
+    /*
+        Stats
+    */
+
+    //Add the counters of another stats
+    void Stats::operator+= (const Stats &s)
+    {
+        for (int o=0;o<static_cast<int>(Op::size);o++)
+            for (int p=0;p<static_cast<int>(Pair::size);p++)
+                calls[o][p]+=s.calls[o][p];
+        for (int e=0;e<static_cast<int>(Evt::size);e++)
+            events[e]+=s.events[e];
+        for (int i=0;i<HIST_SIZE;i++)
+            loop_hist[i]+=s.loop_hist[i];
+    }
+
+    /*
+        Local counters
+    */
+
+    //Registers the counters so they can be aggregated
+    Local::Local()
+    {
+        clear();
+        Registry &r=registry();
+        std::lock_guard<std::mutex> lock(r.m);
+        r.live.push_back(this);
+    }
+
+    //Moves the counters to the retired totals
+    Local::~Local()
+    {
+        Registry &r=registry();
+        std::lock_guard<std::mutex> lock(r.m);
+        r.retired+=read();
+        r.live.erase(std::find(r.live.begin(),r.live.end(),this));
+    }
+
+    //Read the counters
+    Stats Local::read() const
+    {
+        Stats s;
+        for (int o=0;o<static_cast<int>(Op::size);o++)
+            for (int p=0;p<static_cast<int>(Pair::size);p++)
+                s.calls[o][p]=calls[o][p].load(std::memory_order_relaxed);
+        for (int e=0;e<static_cast<int>(Evt::size);e++)
+            s.events[e]=events[e].load(std::memory_order_relaxed);
+        for (int i=0;i<HIST_SIZE;i++)
+            s.loop_hist[i]=loop_hist[i].load(std::memory_order_relaxed);
+        return s;
+    }
+
+    //Set the counters to zero
+    void Local::clear()
+    {
+        for (int o=0;o<static_cast<int>(Op::size);o++)
+            for (int p=0;p<static_cast<int>(Pair::size);p++)
+                calls[o][p].store(0,std::memory_order_relaxed);
+        for (int e=0;e<static_cast<int>(Evt::size);e++)
+            events[e].store(0,std::memory_order_relaxed);
+        for (int i=0;i<HIST_SIZE;i++)
+            loop_hist[i].store(0,std::memory_order_relaxed);
+    }
+
+    /*
+        Functions
+    */
+
+    /* Stats API */
+
+    //Aggregate the counters of all the threads (live and finished)
+    Stats snapshot()
+    {
+        Registry &r=registry();
+        std::lock_guard<std::mutex> lock(r.m);
+        Stats s(r.retired);
+        for (const Local *l : r.live)
+            s+=l->read();
+        return s;
+    }
+
+    //Set all the counters to zero
+    void reset()
+    {
+        Registry &r=registry();
+        std::lock_guard<std::mutex> lock(r.m);
+        r.retired=Stats{};
+        for (Local *l : r.live)
+            l->clear();
+    }
+
+    /* Counting */
+
+    //Counters of the calling thread
+    Local& local()
+    {
+        static thread_local Local l;
+        return l;
+    }
+
+}}}//End of namespace
@@ -0,0 +1,239 @@
+/*
+ * FDX_Trc.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Trc
+    Scoped tracing of the simulation phases (Chrome trace export)
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Trc.hpp"
+
+//Timestamps
+#include <chrono>
+
+//File output
+#include <fstream>
+#include <iomanip>
+
+//Registry of the threads
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+namespace fdx{ namespace arrow { namespace trc
+{
+    /*
+        Ring buffers
+    */
+
+    namespace
+    {
+        //Span stored in a ring buffer, the fields are atomics so the dump can read them while the owner writes
+        struct Entry
+        {
+            std::atomic<const char*> name;
+            std::atomic<std::uint64_t> begin, end;
+        };
+
+        //Ring buffer of a thread, single producer (the owner) and lock-free
+        struct Ring
+        {
+            Entry entries[RING_SIZE];
+            std::atomic<std::uint64_t> head{0};//Number of spans written since the last clear
+            int tid;//Thread id in the trace
+            bool finished=false;//The owner exited, the ring is only kept until its spans are dumped or cleared (guarded by the registry)
+        };
+
+        //Rings of every thread that traced something (rings of finished threads are kept until the next clear)
+        struct Registry
+        {
+            std::mutex m;
+            std::vector<std::unique_ptr<Ring>> rings;
+            int next_tid=0;
+        };
+
+        //Registry (never destroyed, threads may finish after the static destructors)
+        Registry& registry()
+        {
+            static Registry *r=new Registry;
+            return *r;
+        }
+
+        //Ring owned by a thread, handed back to the registry when the thread exits
+        struct Owner
+        {
+            Ring *ring=nullptr;
+
+            //Free the ring if it's empty, otherwise keep it for the dump until the next clear
+            ~Owner()
+            {
+                if (!ring)
+                    return;
+                Registry &r=registry();
+                std::lock_guard<std::mutex> lock(r.m);
+                if (ring->head.load(std::memory_order_relaxed))
+                    ring->finished=true;
+                else
+                    r.rings.erase(std::find_if(r.rings.begin(),r.rings.end(),[this](const std::unique_ptr<Ring> &g){return g.get()==ring;}));
+            }
+        };
+
+        //Ring of the calling thread, created on the first span
+        Ring& local()
+        {
+            static thread_local Owner owner;
+            if (!owner.ring)
+            {
+                Registry &r=registry();
+                std::lock_guard<std::mutex> lock(r.m);
+                r.rings.emplace_back(new Ring);
+                owner.ring=r.rings.back().get();
+                owner.ring->tid=r.next_tid++;
+            }
+            return *owner.ring;
+        }
+
+        //Origin of the timestamps
+        const std::chrono::steady_clock::time_point origin=std::chrono::steady_clock::now();
+    }
+
+    /*
+        Functions
+    */
+
+    /* Control */
+
+    //Flag checked by every span
+    std::atomic<bool> on_flag(false);
+
+    //Enable or disable the tracing
+    void enable(bool e)
+    {
+        on_flag.store(e,std::memory_order_relaxed);
+    }
+
+    //Discard every span recorded so far, freeing the rings of the threads that exited
+    void clear()
+    {
+        Registry &r=registry();
+        std::lock_guard<std::mutex> lock(r.m);
+        r.rings.erase(std::remove_if(r.rings.begin(),r.rings.end(),[](const std::unique_ptr<Ring> &g){return g->finished;}),r.rings.end());
+        for (auto &ring : r.rings)
+            ring->head.store(0,std::memory_order_release);
+    }
+
+    /* Recording */
+
+    //Current time in nanoseconds since the start of the tracer
+    std::uint64_t now()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now()-origin).count();
+    }
+
+    //Store a finished span in the ring buffer of the calling thread
+    void record(const char *name, std::uint64_t begin, std::uint64_t end)
+    {
+        Ring &ring=local();
+        std::uint64_t h=ring.head.load(std::memory_order_relaxed);
+        Entry &e=ring.entries[h&(RING_SIZE-1)];
+        e.name.store(name,std::memory_order_relaxed);
+        e.begin.store(begin,std::memory_order_relaxed);
+        e.end.store(end,std::memory_order_relaxed);
+        ring.head.store(h+1,std::memory_order_release);//Publish the span
+    }
+
+    /* Export */
+
+    //Write every span in the ring buffers as Chrome trace JSON
+    void dump(std::ostream &os)
+    {
+        Registry &r=registry();
+        std::lock_guard<std::mutex> lock(r.m);
+
+        //Format of the stream, restored at the end
+        std::ios_base::fmtflags flags=os.flags();
+        std::streamsize precision=os.precision();
+
+        os << std::fixed << std::setprecision(3) << "{\"traceEvents\":[";
+        bool first=true;
+        std::vector<std::uint64_t> begin(RING_SIZE), end(RING_SIZE);
+        std::vector<const char*> name(RING_SIZE);
+
+        for (auto &ring : r.rings)
+        {
+            //Copy the valid window of the ring
+            std::uint64_t h=ring->head.load(std::memory_order_acquire);
+            std::uint64_t from=h>RING_SIZE?h-RING_SIZE:0;
+            for (std::uint64_t i=from;i<h;i++)
+            {
+                const Entry &e=ring->entries[i&(RING_SIZE-1)];
+                name[i-from]=e.name.load(std::memory_order_relaxed);
+                begin[i-from]=e.begin.load(std::memory_order_relaxed);
+                end[i-from]=e.end.load(std::memory_order_relaxed);
+            }
+
+            //The owner may have overwritten the oldest entries while they were copied, skip them
+            std::uint64_t h2=ring->head.load(std::memory_order_acquire);
+            std::uint64_t valid_from=h2+1>RING_SIZE?std::max(from,h2+1-RING_SIZE):from;
+            if (h2<h)//Cleared while copying
+                continue;
+
+            for (std::uint64_t i=valid_from;i<h;i++)
+            {
+                if (!first)
+                    os << ",";
+                first=false;
+                os  << "{\"name\":\"" << name[i-from] << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << ring->tid
+                    << ",\"ts\":" << begin[i-from]/1000.0 << ",\"dur\":" << (end[i-from]-begin[i-from])/1000.0 << "}";
+            }
+        }
+
+        os << "],\"displayTimeUnit\":\"ns\"}" << std::endl;
+        os.flags(flags);
+        os.precision(precision);
+    }
+
+    //Write the Chrome trace JSON to a file
+    bool dump(const char *path)
+    {
+        std::ofstream f(path);
+        if (!f)
+            return false;
+        dump(f);
+        return static_cast<bool>(f);
+    }
+
+}}}//End of namespace
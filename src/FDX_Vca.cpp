@@ -0,0 +1,281 @@
+/*
+ * FDX_Vca.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Vca
+    Arrays of 2D vectors in columns (SoA) with bulk operations
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Vca.hpp"
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Array of vectors
+    */
+
+    /* Null vector */
+
+    //Unitary version of the null vector given by Vct (only computed once)
+    static const Vct& null_unitary()
+    {
+        static const Vct rv=[]{Vct v; v.unitary(); return v;}();
+        return rv;
+    }
+
+    /* Operators and conversors */
+
+    //Add operator: adds the vectors with the same index (same size)
+    Vca operator+ (const Vca &a, const Vca &b)
+    {
+        Vca rv(a);
+        rv+=b;
+        return rv;
+    }
+
+    //Subtract operator: subtracts the vectors with the same index (same size, first - second)
+    Vca operator- (const Vca &a, const Vca &b)
+    {
+        Vca rv(a);
+        rv-=b;
+        return rv;
+    }
+
+    //Product operator: multiply every vector by a coefficient
+    Vca operator* (const Vca &a, Vct::Mod coefficient)
+    {
+        Vca rv(a);
+        rv*=coefficient;
+        return rv;
+    }
+
+    //Product operator: multiply every vector by a coefficient
+    Vca operator* (Vct::Mod coefficient, const Vca &a)
+    {
+        return a*coefficient;
+    }
+
+    //Negate method: changes the coordinates of every vector to their contrary sign value
+    void Vca::inv_dir()
+    {
+        std::size_t n=size();
+        Coord *px=x.data(), *py=y.data();
+        for (std::size_t i=0;i<n;i++)
+        {
+            px[i]=-px[i];
+            py[i]=-py[i];
+        }
+    }
+
+    //Add to operator: adds the vectors with the same index (same size)
+    void Vca::operator+= (const Vca &v)
+    {
+        std::size_t n=size();
+        Coord *px=x.data(), *py=y.data();
+        const Coord *vx=v.x.data(), *vy=v.y.data();
+        for (std::size_t i=0;i<n;i++)
+        {
+            px[i]+=vx[i];
+            py[i]+=vy[i];
+        }
+    }
+
+    //Substract from operator: substracts the vectors with the same index (same size)
+    void Vca::operator-= (const Vca &v)
+    {
+        std::size_t n=size();
+        Coord *px=x.data(), *py=y.data();
+        const Coord *vx=v.x.data(), *vy=v.y.data();
+        for (std::size_t i=0;i<n;i++)
+        {
+            px[i]-=vx[i];
+            py[i]-=vy[i];
+        }
+    }
+
+    //Add to operator: adds one vector to every vector
+    void Vca::operator+= (const Vct &v)
+    {
+        std::size_t n=size();
+        Coord *px=x.data(), *py=y.data();
+        Coord vx=v.x, vy=v.y;
+        for (std::size_t i=0;i<n;i++)
+        {
+            px[i]+=vx;
+            py[i]+=vy;
+        }
+    }
+
+    //Substract from operator: substracts one vector from every vector
+    void Vca::operator-= (const Vct &v)
+    {
+        std::size_t n=size();
+        Coord *px=x.data(), *py=y.data();
+        Coord vx=v.x, vy=v.y;
+        for (std::size_t i=0;i<n;i++)
+        {
+            px[i]-=vx;
+            py[i]-=vy;
+        }
+    }
+
+    //Multiply by operator: multiplies every vector by a coefficient
+    void Vca::operator*= (Mod coefficient)
+    {
+        std::size_t n=size();
+        Coord *px=x.data(), *py=y.data();
+        for (std::size_t i=0;i<n;i++)
+        {
+            px[i]*=coefficient;
+            py[i]*=coefficient;
+        }
+    }
+
+    //Add the vectors with the same index multiplied by a coefficient (same size, positions += speeds*dt)
+    void Vca::add_scaled (const Vca &v, Mod coefficient)
+    {
+        std::size_t n=size();
+        Coord *px=x.data(), *py=y.data();
+        const Coord *vx=v.x.data(), *vy=v.y.data();
+        for (std::size_t i=0;i<n;i++)
+        {
+            px[i]+=vx[i]*coefficient;
+            py[i]+=vy[i]*coefficient;
+        }
+    }
+
+    /* Conversion to and from Vct */
+
+    //Replace the vectors with the ones of an array
+    void Vca::assign (const Vct *v, std::size_t n)
+    {
+        x.resize(n);
+        y.resize(n);
+        Coord *px=x.data(), *py=y.data();
+        for (std::size_t i=0;i<n;i++)
+        {
+            px[i]=v[i].x;
+            py[i]=v[i].y;
+        }
+    }
+
+    //Write the vectors to an array of size()
+    void Vca::copy_to (Vct *out) const
+    {
+        std::size_t n=size();
+        const Coord *px=x.data(), *py=y.data();
+        for (std::size_t i=0;i<n;i++)
+            out[i].setXY(px[i],py[i]);
+    }
+
+    /* Module operations */
+
+    //Get the squared modules of the vectors
+    void Vca::sq_mod (Mod *out) const
+    {
+        std::size_t n=size();
+        const Coord *px=x.data(), *py=y.data();
+        for (std::size_t i=0;i<n;i++)
+            out[i]=px[i]*px[i]+py[i]*py[i];
+    }
+
+    //Get the modules of the vectors
+    void Vca::mod (Mod *out) const
+    {
+        std::size_t n=size();
+        const Coord *px=x.data(), *py=y.data();
+        for (std::size_t i=0;i<n;i++)
+            out[i]=std::sqrt(px[i]*px[i]+py[i]*py[i]);
+    }
+
+    //Change the module of every vector to the given value (direction inverted if the number is negative)
+    void Vca::limmod (Mod nm)
+    {
+        std::size_t n=size();
+        Coord *px=x.data(), *py=y.data();
+        //Null vectors take the direction that Vct gives them
+        Coord ux=null_unitary().x*nm, uy=null_unitary().y*nm;
+        for (std::size_t i=0;i<n;i++)
+        {
+            //Both results computed, so there are only selects
+            bool nz=(px[i]!=0)|(py[i]!=0);
+            Mod sq=px[i]*px[i]+py[i]*py[i];
+            Mod k=nm/std::sqrt(nz?sq:1);
+            px[i]=nz?px[i]*k:ux;
+            py[i]=nz?py[i]*k:uy;
+        }
+    }
+
+    //Turn every vector into its unitary vector
+    void Vca::unitary()
+    {
+        std::size_t n=size();
+        Coord *px=x.data(), *py=y.data();
+        //Null vectors take the direction that Vct gives them
+        Coord ux=null_unitary().x, uy=null_unitary().y;
+        for (std::size_t i=0;i<n;i++)
+        {
+            //Both results computed, so there are only selects
+            bool nz=(px[i]!=0)|(py[i]!=0);
+            Mod sq=px[i]*px[i]+py[i]*py[i];
+            Mod k=1/std::sqrt(nz?sq:1);
+            px[i]=nz?px[i]*k:ux;
+            py[i]=nz?py[i]*k:uy;
+        }
+    }
+
+    /* Products */
+
+    //Dot product of the vectors with the same index (same size)
+    void Vca::dot (const Vca &v, Mod *out) const
+    {
+        std::size_t n=size();
+        const Coord *px=x.data(), *py=y.data();
+        const Coord *vx=v.x.data(), *vy=v.y.data();
+        for (std::size_t i=0;i<n;i++)
+            out[i]=px[i]*vx[i]+py[i]*vy[i];
+    }
+
+    //Dot product of every vector with a given vector
+    void Vca::dot (const Vct &v, Mod *out) const
+    {
+        std::size_t n=size();
+        const Coord *px=x.data(), *py=y.data();
+        Coord vx=v.x, vy=v.y;
+        for (std::size_t i=0;i<n;i++)
+            out[i]=px[i]*vx+py[i]*vy;
+    }
+
+}}//End of namespace
@@ -43,69 +43,98 @@
 namespace fdx{ namespace arrow
 {
     /*
-        Functions
+        Trigonometry
     */
 
-    /*Comparison of coordinates and angles*/
+#ifdef FDX_ARROW_FAST_TRIG
 
-    /*Checks if two doubles are almost identical (using EPSILON fast method)
-      Not safe if the values are close to zero, use with caution*/
-    bool almost_equal(double a, double b)
-    {
-        return
-            (
-                (a==b)//First, fast comparision
-                ||
-                (std::abs(a-b)<EPSILON_COMP)//Second comparision, not safe for all range of values
-            );
-    }
-
-    /*
-        Vector
-    */
-
-    /* Vector friends */
+    /* Approximations
+       Branchless polynomials (minimax, single precision coefficients) so the batches vectorize */
 
-    /*Operators and conversors*/
+    //Greatest number of quadrants of the angles reduced (angles must be within 1e9 radians)
+    constexpr Vct::Mod TRG_MAX_QUADRANT=1e9;
 
-    //Equality operator: same X and Y coordinates
-    bool operator==(const Vct &a, const Vct &b)
+    //Sine and cosine of an angle
+    inline void trg_sin_cos (Vct::Mod a, Vct::Mod &s, Vct::Mod &c)
     {
-        return (almost_equal(a.x,b.x)&&almost_equal(a.y,b.y));
+        //Reduce to [-PI/4,PI/4] around the closest multiple of PI/2 (PI/2 split in two parts to keep the precision)
+        Vct::Mod h=std::min(std::max(a*(2/PI),-TRG_MAX_QUADRANT),TRG_MAX_QUADRANT);
+        int k=static_cast<int>(h+std::copysign(0.5,h));
+        Vct::Mod q=k;
+        Vct::Mod r=(a-q*1.5707963267341256)-q*6.077100506506192e-11;
+
+        //Polynomials on the reduced angle
+        Vct::Mod z=r*r;
+        Vct::Mod ps=r+r*z*(-1.6666654611e-1+z*(8.3321608736e-3+z*(-1.9515295891e-4)));
+        Vct::Mod pc=1-0.5*z+z*z*(4.166664568298827e-2+z*(-1.388731625493765e-3+z*2.443315711809948e-5));
+
+        //Quadrant
+        bool swap=k&1, neg_s=k&2, neg_c=(k+1)&2;
+        s=swap?pc:ps;
+        c=swap?ps:pc;
+        s=neg_s?-s:s;
+        c=neg_c?-c:c;
     }
 
-    //Inequality operator: opposite of equality
-    bool operator!=(const Vct &a, const Vct &b)
+    //Angle of the point (x,y) with +OX, within [-PI,PI]
+    inline Vct::Mod trg_atan2 (Vct::Mod y, Vct::Mod x)
     {
-        return !(a==b);
+        //Reduce to the first octant
+        Vct::Mod ax=std::abs(x), ay=std::abs(y);
+        Vct::Mod hi=std::max(ax,ay), lo=std::min(ax,ay);
+        Vct::Mod t=lo/(hi>0?hi:1);
+
+        //Reduce to [-tan(PI/8),tan(PI/8)] (both computed, so there are only selects)
+        bool big=t>0.4142135623730950;
+        Vct::Mod tb=(t-1)/(t+1);
+        Vct::Mod u=big?tb:t;
+
+        //Polynomial
+        Vct::Mod z=u*u;
+        Vct::Mod a=u+u*z*(-3.33329491539e-1+z*(1.99777106478e-1+z*(-1.38776856032e-1+z*8.05374449538e-2)));
+
+        //Back to the quadrant (only constants and signs are selected, selected arithmetic could trap and isn't vectorized)
+        a+=big?PI/4:0;
+        a=(ay>ax?PI/2:0)+(ay>ax?-a:a);
+        a=(x<0?PI:0)+(x<0?-a:a);
+        return y<0?-a:a;
     }
 
-    /*Operators and conversors*/
+#else
 
-    //Add operator: adds X and Y coordinates by separate to create a new vector
-    Vct operator+(const Vct &a, const Vct &b)
-    {
-        return Vct (a.x+b.x,a.y+b.y);
-    }
+    /* Standard maths */
 
-    //Subtract operator: subtracts the X and Y coordinates by separate to create a new vector (first - second)
-    Vct operator-(const Vct &a, const Vct &b)
+    //Sine and cosine of an angle
+    inline void trg_sin_cos (Vct::Mod a, Vct::Mod &s, Vct::Mod &c)
     {
-        return Vct (a.x-b.x,a.y-b.y);
+        s=std::sin(a);
+        c=std::cos(a);
     }
 
-    //Product operator: multiply the X and Y coordinates by a coefficient
-    Vct operator* (const Vct &a, Vct::Mod coefficient)
+    //Angle of the point (x,y) with +OX, within [-PI,PI]
+    inline Vct::Mod trg_atan2 (Vct::Mod y, Vct::Mod x)
     {
-        return Vct (a,coefficient);
+        return std::atan2(y,x);
     }
 
-    //Product operator: multiply the X and Y coordinates by a coefficient
-    Vct operator* (Vct::Mod coefficient, const Vct &a)
+#endif
+
+    //Angle with +OX of a not reversed vector, within [0,2*PI) (the null vector gives the default angle)
+    inline Vct::Mod trg_angle (Vct::Mod x, Vct::Mod y, Vct::Mod null_angle)
     {
-        return Vct (a,coefficient);
+        Vct::Mod rv=trg_atan2(y,x);
+        rv+=rv<0?2*PI:0;
+        return (x||y)?rv:null_angle;
     }
 
+    /*
+        Vector
+    */
+
+    /* Vector friends */
+
+    /*Operators and conversors*/
+
     //Input operator
     std::istream &operator>> (std::istream &is, Vct &v)
     {
@@ -124,44 +153,6 @@ namespace fdx{ namespace arrow
         Vector methods
     */
 
-    /*Module operations*/
-
-    //Change the module of this vector to the given value (direction inverted if the number is negative)
-    void Vct::limmod (Mod nm)
-    {
-        //If this vector is not null, multiply it by a coefficient
-        if (operator bool())
-        {
-            operator*=(nm/mod());
-        }
-        //If the operator is null...
-        else
-        {
-            /*...if null is allowed, no operation is performed,
-              else, we use the angle to turn it into an unary vector*/
-            if (!DEF_NULL_ALLOWED)//null vector is not allowed
-                set_ang_mod(DEF_NULL_UNI_ANGLE,nm);
-        }
-    }
-
-    //Turn this vector into the unitary vector
-    void Vct::unitary()
-    {
-        //If this vector is not null, multiply it by the inverse of its module
-        if (operator bool())
-        {
-            operator*=(1/mod());
-        }
-        //If the operator is null...
-        else
-        {
-            /*...if null is allowed, no operation is performed,
-              else, we use the angle to turn it into an unary vector*/
-            if (!DEF_NULL_ALLOWED)//null vector is not allowed
-                set_ang_mod(DEF_NULL_UNI_ANGLE);
-        }
-    }
-
     /*Angle operations*/
 
     /*Define a vector with a given angle and module
@@ -172,29 +163,35 @@ namespace fdx{ namespace arrow
     {
         /*Return a new vector with the X and Y coordinates calculated
           using the angle and the module, reversed if needed*/
+        Mod s,c;
+        trg_sin_cos(angle,s,c);
         return Vct   (
-                            std::cos(angle)*(DEF_REVER_X?-module:module)//X coordinate
+                            c*(DEF_REVER_X?-module:module)//X coordinate
                             ,
-                            std::sin(angle)*(DEF_REVER_Y?-module:module)//Y coordinate
+                            s*(DEF_REVER_Y?-module:module)//Y coordinate
                         );
     }
 
     //Sets this vector with the given angle and module
     void Vct::set_ang_mod (Mod nangle, Mod nmodule)
     {
+        Mod s,c;
+        trg_sin_cos(nangle,s,c);
         //Get X using the cos and invert if needed
-        x=std::cos(nangle)*(DEF_REVER_X?-nmodule:nmodule);
+        x=c*(DEF_REVER_X?-nmodule:nmodule);
         //Get Y using the sin and invert if needed
-        y=std::sin(nangle)*(DEF_REVER_Y?-nmodule:nmodule);
+        y=s*(DEF_REVER_Y?-nmodule:nmodule);
     }
 
     //Sets this vector as an unitary vector with the given angle
     void Vct::set_ang_mod (Mod angle)
     {
+        Mod s,c;
+        trg_sin_cos(angle,s,c);
         //Get X using the cos and invert if needed
-        x=DEF_REVER_X?-std::cos(angle):std::cos(angle);
+        x=DEF_REVER_X?-c:c;
         //Get Y using the sin and invert if needed
-        y=DEF_REVER_Y?-std::sin(angle):std::sin(angle);
+        y=DEF_REVER_Y?-s:s;
     }
 
     //Get the angle that this vectors forms with +OX or another vector
@@ -210,7 +207,7 @@ namespace fdx{ namespace arrow
             //Reverse its coordinates if needed
             c.rev_cord();
             //Calculate the angle using atan2
-            Mod rv=std::atan2(c.y,c.x);
+            Mod rv=trg_atan2(c.y,c.x);
             //If the angle is negative, we turn it into positive
             if (rv<0)
                 return (2*PI)+rv;
@@ -221,4 +218,44 @@ namespace fdx{ namespace arrow
         return DEF_NULL_UNI_ANGLE;
     }
 
+    /*Batches*/
+
+    //Create vectors with the given angles and modules, into the arrays of coordinates
+    void Vct::mk_ang_mod (const Mod *angle, const Mod *module, Coord *x, Coord *y, std::size_t n)
+    {
+        for (std::size_t i=0;i<n;i++)
+        {
+            Mod s,c;
+            trg_sin_cos(angle[i],s,c);
+            x[i]=c*(DEF_REVER_X?-module[i]:module[i]);
+            y[i]=s*(DEF_REVER_Y?-module[i]:module[i]);
+        }
+    }
+
+    //Create vectors with the given angles and modules
+    void Vct::mk_ang_mod (const Mod *angle, const Mod *module, Vct *out, std::size_t n)
+    {
+        for (std::size_t i=0;i<n;i++)
+        {
+            Mod s,c;
+            trg_sin_cos(angle[i],s,c);
+            out[i].x=c*(DEF_REVER_X?-module[i]:module[i]);
+            out[i].y=s*(DEF_REVER_Y?-module[i]:module[i]);
+        }
+    }
+
+    //Get the angles that the vectors, given by their arrays of coordinates, form with +OX
+    void Vct::angle (const Coord *x, const Coord *y, Mod *out, std::size_t n)
+    {
+        for (std::size_t i=0;i<n;i++)
+            out[i]=trg_angle(DEF_REVER_X?-x[i]:x[i],DEF_REVER_Y?-y[i]:y[i],DEF_NULL_UNI_ANGLE);
+    }
+
+    //Get the angles that the vectors form with +OX
+    void Vct::angle (const Vct *v, Mod *out, std::size_t n)
+    {
+        for (std::size_t i=0;i<n;i++)
+            out[i]=trg_angle(DEF_REVER_X?-v[i].x:v[i].x,DEF_REVER_Y?-v[i].y:v[i].y,DEF_NULL_UNI_ANGLE);
+    }
+
 }}//End of namespace
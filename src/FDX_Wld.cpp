@@ -0,0 +1,179 @@
+/*
+ * FDX_Wld.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Wld
+    World of bodies published as snapshots for readers without locks
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Wld.hpp"
+
+//Tracing
+#include "../include/FDX_Trc.hpp"
+
+//Oldest epoch
+#include <algorithm>
+
+//Waiting for a free slot
+#include <thread>
+
+namespace fdx{ namespace arrow
+{
+    /*
+        View of a reader
+    */
+
+    //Pin the epoch of the world in a slot and read the snapshot
+    Wld::View::View (const Wld &w)
+    :world(&w), slot(0), snp(nullptr)
+    {
+        //Take a free slot with the current epoch (a snapshot replaced from now on will wait for this reader)
+        for (;;)
+        {
+            std::uint64_t e=w.epoch.load();
+            std::uint64_t idle=IDLE;
+            if (w.slots[slot].epoch.compare_exchange_strong(idle,e))
+                break;
+            if (++slot==MAX_READERS)//Every slot is taken, wait for a reader to end
+            {
+                slot=0;
+                std::this_thread::yield();
+            }
+        }
+
+        /*Read the snapshot after the slot is visible (both sequentially consistent):
+          if this is a snapshot being replaced, the writer sees the slot before reclaiming it*/
+        snp=w.current.load();
+    }
+
+    //Destructor, releases the slot
+    Wld::View::~View()
+    {
+        if (world)
+            world->slots[slot].epoch.store(IDLE,std::memory_order_release);
+    }
+
+    /*
+        World
+    */
+
+    //Greatest number of readers active at the same time
+    constexpr std::size_t Wld::MAX_READERS;
+
+    //Epoch of a free slot
+    constexpr std::uint64_t Wld::IDLE;
+
+    /* Constructors, copy control */
+
+    //Default constructor, publishes an empty snapshot
+    Wld::Wld()
+    :current(nullptr), epoch(1), published(0)
+    {
+        for (Slot &s : slots)
+            s.epoch.store(IDLE,std::memory_order_relaxed);
+        publish();
+    }
+
+    //Destructor
+    Wld::~Wld()
+    {
+        delete current.load();
+        for (Snp *s : retired)
+            delete s;
+        for (Snp *s : spare)
+            delete s;
+    }
+
+    /* Writer */
+
+    //Publish a snapshot of the bodies of the writer
+    void Wld::publish()
+    {
+        FDX_TRC_SPAN("publish");
+
+        //Build the next snapshot, reusing the memory of a spare one
+        Snp *s;
+        if (!spare.empty())
+        {
+            s=spare.back();
+            spare.pop_back();
+        }
+        else
+            s=new Snp();
+        s->bodies=work;
+        s->boxes.resize(work.size());
+        work.bounds(0,work.size(),s->boxes.data());
+        if (s->bvh.count()!=s->boxes.size())//Bodies added or removed, build again
+            s->bvh.build(s->boxes);
+        else
+            s->bvh.refit(s->boxes);
+        s->version=published++;
+
+        //Swap it with the one published, the old one is retired in the epoch that starts now
+        const Snp *old=current.exchange(s);
+        if (old)
+        {
+            Snp *o=const_cast<Snp*>(old);
+            o->retired=epoch.fetch_add(1)+1;
+            retired.push_back(o);
+        }
+        reclaim();
+    }
+
+    //Move the snapshots that can't be read anymore to the spares
+    void Wld::reclaim()
+    {
+        //Oldest epoch pinned by a reader
+        std::uint64_t oldest=~std::uint64_t(0);
+        for (const Slot &s : slots)
+        {
+            std::uint64_t e=s.epoch.load();
+            if (e!=IDLE)
+                oldest=std::min(oldest,e);
+        }
+
+        //Readers pinned in the epoch of the retirement or later only see the newer snapshots
+        std::size_t k=0;
+        for (Snp *s : retired)
+        {
+            if (s->retired<=oldest)
+                spare.push_back(s);
+            else
+                retired[k++]=s;
+        }
+        retired.resize(k);
+    }
+
+}}//End of namespace
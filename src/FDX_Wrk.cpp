@@ -0,0 +1,114 @@
+/*
+ * FDX_Wrk.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Wrk
+    Pool of worker threads
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Header file
+#include "../include/FDX_Wrk.hpp"
+
+//Number of threads
+#include <algorithm>
+
+namespace fdx{ namespace arrow
+{
+    /*
+        Pool of workers
+    */
+
+    /* Constructors, copy control */
+
+    //Constructor with the number of threads
+    Wrk::Wrk (unsigned nthreads)
+    :stop(false)
+    {
+        if (!nthreads)
+            nthreads=std::max(1u,std::thread::hardware_concurrency());
+        workers.reserve(nthreads);
+        for (unsigned i=0;i<nthreads;i++)
+            workers.emplace_back(&Wrk::work,this);
+    }
+
+    //Destructor, runs the tasks left and joins the threads
+    Wrk::~Wrk()
+    {
+        {
+            std::lock_guard<std::mutex> g(lock);
+            stop=true;
+        }
+        ready.notify_all();
+        for (std::thread &t : workers)
+            t.join();
+    }
+
+    /* Tasks */
+
+    //Add a task to the queue
+    void Wrk::post (Task t)
+    {
+        {
+            std::lock_guard<std::mutex> g(lock);
+            tasks.push_back(std::move(t));
+        }
+        ready.notify_one();
+    }
+
+    //Pool shared by the library
+    Wrk& Wrk::shared()
+    {
+        static Wrk pool;
+        return pool;
+    }
+
+    //Loop of a worker thread
+    void Wrk::work()
+    {
+        for (;;)
+        {
+            Task t;
+            {
+                std::unique_lock<std::mutex> g(lock);
+                ready.wait(g,[this]{return stop||!tasks.empty();});
+                if (tasks.empty())//Only when stopping
+                    return;
+                t=std::move(tasks.front());
+                tasks.pop_front();
+            }
+            t();
+        }
+    }
+
+}}//End of namespace
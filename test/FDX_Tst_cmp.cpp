@@ -0,0 +1,90 @@
+/*
+ * FDX_Tst_cmp.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Tst_cmp
+    Regression checks of the movement of shapes against compounds
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Compounds
+#include "../include/FDX_Cmp.hpp"
+
+//Report of the failures
+#include <cstdio>
+
+//Infinite distances
+#include <cmath>
+
+using namespace fdx::arrow;
+
+//Compound of a rectangle and an oriented rectangle next to it, a slide along one of them turns into the other
+Cmp rct_obb()
+{
+    Cmp m(Vct(0,0));
+    m.add(Rct(Vct(4,-2.5),Vct(3,1)));
+    m.add(Obb(Vct(4,3),Vct(1,3),0.75*3.14159265358979));
+    return m;
+}
+
+//Check that a circle moves against the compound without ending inside it, and that its movement is limited
+bool check (const char *name, const Cmp &m, const Crl &c, const Vct &speed, const Vct &mov)
+{
+    Crl end(c.get_pos_center()+mov,c.get_size()*0.999);
+    if (mov!=speed&&!end.contact(m))
+        return true;
+    std::printf("%s: moved (%g,%g) of (%g,%g), ends inside %d\n",name,mov.x,mov.y,speed.x,speed.y,end.contact(m));
+    return false;
+}
+
+int main()
+{
+    bool ok=true;
+
+    //A circle is limited by the oriented rectangle, then by the rectangle, and its slide turns back into the oriented rectangle
+    Cmp m(rct_obb());
+    Crl c(Vct(8,2),1.5);
+    ok&=check("circle against compound",m,c,Vct(-5,-6.5),c.mov_against(m,Vct(-5,-6.5)));
+
+    //The same movement seen from the compound
+    ok&=check("compound against circle",m,c,Vct(-5,-6.5),-m.mov_against(c,Vct(5,6.5)));
+
+    //An empty compound is infinitely far from every point
+    if (!std::isinf(Cmp(Vct(1,1)).sq_dist(Vct(0,0))))
+    {
+        std::printf("empty compound: finite distance\n");
+        ok=false;
+    }
+
+    return ok?0:1;
+}
@@ -0,0 +1,78 @@
+/*
+ * FDX_Tst_crl.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Tst_crl
+    Regression checks of the time to hit of circles and points against rectangles
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Shapes
+#include "../include/FDX_Geo.hpp"
+
+//Report of the failures
+#include <cstdio>
+
+using namespace fdx::arrow;
+
+//Check that the shape hits the rectangle at the expected time (negative if it never hits), returns false and reports it if not
+bool check (const char *name, const Shp &s, const Rct &r, const Vct &speed, Vct::Mod expected)
+{
+    Vct::Mod t=s.tth(r,speed);
+    if ((t<0&&expected<0)||almost_equal(t,expected))
+        return true;
+    std::printf("%s: got %g, expected %g\n",name,t,expected);
+    return false;
+}
+
+int main()
+{
+    bool ok=true;
+
+    //Point passing beside a corner, it reaches the Y of the rectangle before its X: it never hits
+    ok&=check("point beside corner",Pnt(Vct(-1,-2)),Rct(Vct(7,1),Vct(3,1)),Vct(6,7),-1);
+
+    //Circle passing beside a corner, only the Y axis enters the side area
+    ok&=check("circle beside corner",Crl(Vct(1,4),1),Rct(Vct(7,-4),Vct(2,4)),Vct(5,-11),-1);
+
+    //Circle hitting a side after leaving the corner area through the other axis
+    ok&=check("circle side after corner",Crl(Vct(1,-1),2),Rct(Vct(1,-6),Vct(4,2)),Vct(8,-2),0.5);
+
+    //Circle hitting the corner before reaching the side
+    ok&=check("circle corner",Crl(Vct(-4,8),1),Rct(Vct(-7,6),Vct(1,2)),Vct(-10,-10),0.1);
+
+    //Point entering the rectangle exactly through a corner
+    ok&=check("point through corner",Pnt(Vct(-6,7)),Rct(Vct(-5,-2),Vct(1,4)),Vct(2,-10),0.5);
+
+    return ok?0:1;
+}
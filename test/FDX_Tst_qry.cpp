@@ -0,0 +1,204 @@
+/*
+ * FDX_Tst_qry.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Tst_qry
+    Checks of the batches of queries against the virtual calls
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Batches of queries and compounds
+#include "../include/FDX_Qry.hpp"
+#include "../include/FDX_Cmp.hpp"
+
+//Report of the failures
+#include <cstdio>
+
+//Shapes and random queries
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+using namespace fdx::arrow;
+
+//Number of random queries
+constexpr std::size_t QUERIES=40000;
+
+//Circle whose generic contact throws, a compound against it throws inside a task
+class Faulty : public Crl
+{
+    public:
+
+        using Crl::Crl;
+        using Crl::contact;
+
+        //Throws always
+        bool contact (const Shp &) const override
+        {
+            throw std::runtime_error("faulty shape");
+        }
+};
+
+//Random queries over every type of shape
+struct Batch
+{
+    std::vector<std::unique_ptr<Shp>> shapes;//Shapes of the queries
+    std::vector<std::size_t> a, b;//Shapes of each query
+    std::vector<Vct> speed;//Speed of each query
+    std::vector<Qry::Kind> kind;//Kind of each query
+    Qry q;//Batch
+
+    Batch()
+    {
+        std::mt19937 g(5);
+        std::uniform_real_distribution<Vct::Mod> d(-10,10);
+        for (int i=0;i<600;i++)
+        {
+            Vct p(d(g),d(g));
+            switch (i%6)
+            {
+                case 0: shapes.emplace_back(new Crl(p,1)); break;
+                case 1: shapes.emplace_back(new Pnt(p)); break;
+                case 2: shapes.emplace_back(new Rct(p,Vct(2,1))); break;
+                case 3: shapes.emplace_back(new Obb(p,Vct(2,1),0.4)); break;
+                case 4: shapes.emplace_back(new Cap(p,p+Vct(1,2),0.5)); break;
+                default:
+                {
+                    Cmp *c=new Cmp();
+                    c->add(Crl(p,1));
+                    c->add(Rct(p+Vct(1,0),Vct(1,1)));
+                    shapes.emplace_back(c);
+                }
+            }
+        }
+        for (std::size_t k=0;k<QUERIES;k++)
+        {
+            a.push_back(g()%shapes.size());
+            b.push_back(g()%shapes.size());
+            speed.emplace_back(d(g),d(g));
+            kind.push_back(static_cast<Qry::Kind>(g()%4));
+            const Shp &sa=*shapes[a.back()], &sb=*shapes[b.back()];
+            switch (kind.back())
+            {
+                case Qry::Kind::contact: q.contact(sa,sb); break;
+                case Qry::Kind::tth: q.tth(sa,sb,speed.back()); break;
+                case Qry::Kind::toi: q.toi(sa,sb,speed.back()); break;
+                case Qry::Kind::mov_against: q.mov_against(sa,sb,speed.back()); break;
+            }
+        }
+    }
+
+    //Number of results that differ from the virtual calls
+    std::size_t wrong() const
+    {
+        std::size_t rv=0;
+        for (std::size_t k=0;k<QUERIES;k++)
+        {
+            const Shp &sa=*shapes[a[k]], &sb=*shapes[b[k]];
+            switch (kind[k])
+            {
+                case Qry::Kind::contact:
+                    rv+=q.get_contact(k)!=sa.contact(sb);
+                    break;
+                case Qry::Kind::tth:
+                    rv+=q.get_tth(k)!=sa.tth(sb,speed[k]);
+                    break;
+                case Qry::Kind::toi:
+                {
+                    Toi t=sa.toi(sb,speed[k]);
+                    rv+=q.get_toi(k).t!=t.t;
+                    break;
+                }
+                case Qry::Kind::mov_against:
+                {
+                    Vct m=sa.mov_against(sb,speed[k]);
+                    rv+=q.get_mov_against(k).x!=m.x||q.get_mov_against(k).y!=m.y;
+                    break;
+                }
+            }
+        }
+        return rv;
+    }
+};
+
+//Check that every result of a run matches the virtual calls
+bool check (const char *name, const Batch &b)
+{
+    std::size_t wrong=b.wrong();
+    if (!wrong)
+        return true;
+    std::printf("%s: %zu of %zu results differ from the virtual calls\n",name,wrong,QUERIES);
+    return false;
+}
+
+//A task that throws must end the run with its exception, and the pool must keep working
+bool check_throw (Batch &b)
+{
+    Cmp c;
+    c.add(Crl(Vct(0,0),1));
+    Faulty f(Vct(0.5,0),1);
+    Qry q;
+    q.contact(c,f);
+    q.contact(*b.shapes[0],*b.shapes[1]);
+    bool thrown=false;
+    try
+    {
+        q.run_async().get();
+    }
+    catch (const std::runtime_error &)
+    {
+        thrown=true;
+    }
+    if (!thrown)
+    {
+        std::printf("throw: the future didn't rethrow the exception of the task\n");
+        return false;
+    }
+    b.q.run_async().get();
+    return check("after throw",b);
+}
+
+int main()
+{
+    bool ok=true;
+    Batch b;
+    b.q.run();
+    ok&=check("sync",b);
+    b.q.run_async().get();
+    ok&=check("async",b);
+    ok&=check_throw(b);
+    Qry empty;
+    empty.run_async().get();
+    return ok?0:1;
+}
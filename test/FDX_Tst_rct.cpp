@@ -0,0 +1,91 @@
+/*
+ * FDX_Tst_rct.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Tst_rct
+    Regression checks of the movement of rectangles against rectangles
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Shapes
+#include "../include/FDX_Geo.hpp"
+
+//Report of the failures
+#include <cstdio>
+
+using namespace fdx::arrow;
+
+//Check that the first rectangle moves against the second as expected, returns false and reports it if not
+bool check (const char *name, const Rct &r1, const Rct &r2, const Vct &speed, const Vct &expected)
+{
+    Vct m(r1.mov_against(r2,speed));
+    if (m==expected)
+        return true;
+    std::printf("%s: got (%g,%g), expected (%g,%g)\n",name,m.x,m.y,expected.x,expected.y);
+    return false;
+}
+
+//Check the time for the first rectangle to hit the second, returns false and reports it if not
+bool check_tth (const char *name, const Rct &r1, const Rct &r2, const Vct &speed, Vct::Mod expected)
+{
+    Vct::Mod t=r1.tth(r2,speed);
+    if (t==expected)
+        return true;
+    std::printf("%s: got %g, expected %g\n",name,t,expected);
+    return false;
+}
+
+int main()
+{
+    bool ok=true;
+
+    //Corner graze, the Y axis ends its contact when the X axis starts it: the movement is not limited
+    ok&=check("corner graze",Rct(Vct(-4.5,-6),Vct(1,3)),Rct(Vct(-2.5,-8),Vct(1.5,4)),Vct(3,-15),Vct(3,-15));
+
+    //Sliding along a side, the static axis only touches: the movement is not limited
+    ok&=check("side slide",Rct(Vct(-4.5,6),Vct(3.5,6.5)),Rct(Vct(9,-1),Vct(1,7)),Vct(19,0),Vct(19,0));
+
+    //Inside contact with the same centers, there's no direction to limit
+    ok&=check("same centers",Rct(Vct(0.5,2),Vct(6,6.5)),Rct(Vct(3,4),Vct(1,2.5)),Vct(-11,5),Vct(-11,5));
+
+    //Side hit, the movement stops at the side and keeps the other axis
+    ok&=check("side hit",Rct(Vct(0,0),Vct(1,1)),Rct(Vct(3,-5),Vct(1,10)),Vct(4,1),Vct(2,1));
+
+    //The TTH is negative without a hit ahead, and not limited to the tick
+    ok&=check_tth("tth miss",Rct(Vct(0,0),Vct(1,1)),Rct(Vct(3,5),Vct(1,1)),Vct(4,0),-1);
+    ok&=check_tth("tth behind",Rct(Vct(0,0),Vct(1,1)),Rct(Vct(-3,0),Vct(1,1)),Vct(4,0),-1);
+    ok&=check_tth("tth after the tick",Rct(Vct(0,0),Vct(1,1)),Rct(Vct(9,0),Vct(1,1)),Vct(4,0),2);
+    ok&=check_tth("tth in the tick",Rct(Vct(0,0),Vct(1,1)),Rct(Vct(3,0),Vct(1,1)),Vct(4,0),0.5);
+
+    return ok?0:1;
+}
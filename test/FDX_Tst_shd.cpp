@@ -0,0 +1,228 @@
+/*
+ * FDX_Tst_shd.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Tst_shd
+    Shards of a world run by several processes
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Shards
+#include "../include/FDX_Shd.hpp"
+
+//Report of the failures
+#include <cstdio>
+
+//Owners of the bodies, shared by the processes
+#include <atomic>
+#include <chrono>
+#include <string>
+
+//Processes
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+using namespace fdx::arrow;
+
+//Number of ticks
+constexpr int TICKS=100;
+
+//Number of bodies
+constexpr int BODIES=40;
+
+//Partition in 3 x 2 cells of 30 x 30, with a halo of 4
+const Shd_map MAP(Box(Vct(0,0),Vct(90,60)),3,2,4);
+
+//Prefix of the segments of a check, unique for the process of the test (the first call is before the forks)
+std::string prefix (const char *name)
+{
+    static const std::string pid=std::to_string(getpid());
+    return std::string("fdx_tst_shd_")+name+"_"+pid;
+}
+
+//Run of the shards, the same for the processes of a check
+std::uint64_t run_id()
+{
+    return static_cast<std::uint64_t>(std::chrono::steady_clock::now().time_since_epoch().count());
+}
+
+//Start of a body
+Vct start (int i)
+{
+    return Vct(5+(i%10)*8.5,5+(i/10)*13);
+}
+
+//Speed of a body, the first one crosses two cells in the first tick and then stops
+Vct speed (int i, int tick)
+{
+    if (!i)
+        return tick?Vct():Vct(65,0);
+    return Vct((i%3-1)*0.7,(i%5-2)*0.3);
+}
+
+/*Shard of a process, moves its bodies (bouncing on the world) and counts the owner of each body in every tick
+  The counts are in memory shared by every process, returns the exit code of the process*/
+int shard (std::uint32_t id, std::uint64_t run, std::atomic<int> (*owners)[BODIES], std::atomic<int> *forwarded)
+{
+    Shd s(MAP,id,prefix("move"),run,256);
+    if (!s.valid())
+        return 1;
+    for (int i=0;i<BODIES;i++)
+        if (MAP.shard(start(i))==id)
+            s.add(i,Crl(start(i),1),speed(i,0));
+    int rv=0;
+    for (int t=0;t<TICKS;t++)
+    {
+        Bdy_store &b=s.bodies();
+        for (std::size_t i=0;i<b.size();i++)
+        {
+            int g=static_cast<int>(s.get_gid(b.handle(i)));
+            Vct v=g?Vct(b.speed_x()[i],b.speed_y()[i]):speed(0,t);
+            b.pos_x()[i]+=v.x;
+            b.pos_y()[i]+=v.y;
+            if (b.pos_x()[i]<0||b.pos_x()[i]>90)
+                v.x=-v.x;
+            if (b.pos_y()[i]<0||b.pos_y()[i]>60)
+                v.y=-v.y;
+            b.speed_x()[i]=v.x;
+            b.speed_y()[i]=v.y;
+        }
+        if (!s.exchange())
+            rv=1;
+        for (std::size_t i=0;i<b.size();i++)
+            owners[t][s.get_gid(b.handle(i))]++;
+        *forwarded+=s.get_forwarded();
+    }
+    return rv;
+}
+
+//Every body is owned by a single shard in every tick, and the fast one ends in its region after being forwarded
+bool check_move()
+{
+    auto *owners=static_cast<std::atomic<int>(*)[BODIES]>(mmap(nullptr,sizeof(std::atomic<int>[TICKS][BODIES])+sizeof(std::atomic<int>),
+                                                             PROT_READ|PROT_WRITE,MAP_SHARED|MAP_ANONYMOUS,-1,0));
+    if (owners==MAP_FAILED)
+    {
+        std::printf("move: can't map the owners\n");
+        return false;
+    }
+    std::atomic<int> *forwarded=reinterpret_cast<std::atomic<int>*>(owners+TICKS);
+    std::uint64_t run=run_id();
+    for (std::uint32_t id=1;id<MAP.count();id++)
+        if (!fork())
+            _exit(shard(id,run,owners,forwarded));
+    bool ok=!shard(0,run,owners,forwarded);
+    int status;
+    while (wait(&status)>0)
+        ok&=WIFEXITED(status)&&!WEXITSTATUS(status);
+    if (!ok)
+        std::printf("move: an exchange failed\n");
+
+    int wrong=0;
+    for (int t=0;t<TICKS;t++)
+        for (int i=0;i<BODIES;i++)
+            wrong+=owners[t][i]!=1;
+    if (wrong)
+        std::printf("move: %d bodies without a single owner\n",wrong);
+    if (*forwarded!=1)
+        std::printf("move: %d bodies forwarded, expected 1\n",forwarded->load());
+    ok&=!wrong&&*forwarded==1;
+    munmap(owners,sizeof(std::atomic<int>[TICKS][BODIES])+sizeof(std::atomic<int>));
+    return ok;
+}
+
+//A neighbour that never starts makes the exchange fail after the timeout, and so does a neighbour that dies
+bool check_timeout()
+{
+    Shd_map m(Box(Vct(0,0),Vct(20,10)),2,1,1);
+    std::uint64_t run=run_id();
+    bool ok=true;
+    {
+        Shd s(m,0,prefix("alone"),run,16);
+        s.set_timeout(0.2);
+        auto t0=std::chrono::steady_clock::now();
+        if (s.exchange())
+        {
+            std::printf("timeout: exchange without a neighbour\n");
+            ok=false;
+        }
+        if (std::chrono::steady_clock::now()-t0>std::chrono::seconds(5))
+        {
+            std::printf("timeout: the missing neighbour wasn't detected in time\n");
+            ok=false;
+        }
+    }
+
+    //The neighbour exchanges 3 ticks and exits (removing its segment)
+    if (!fork())
+    {
+        bool rv;
+        {
+            Shd s(m,1,prefix("dead"),run,16);
+            rv=s.valid();
+            for (int t=0;t<3;t++)
+                rv&=s.exchange();
+        }
+        _exit(rv?0:1);
+    }
+    Shd s(m,0,prefix("dead"),run,16);
+    s.set_timeout(2);
+    int done=0;
+    while (done<10&&s.exchange())
+        done++;
+    int status;
+    wait(&status);
+    if (done!=3||WEXITSTATUS(status))
+    {
+        std::printf("timeout: %d exchanges with a neighbour that exits after 3\n",done);
+        ok=false;
+    }
+
+    //Waiting again for the same tick fails without writing it again
+    if (s.exchange()||s.get_tick()!=4)
+    {
+        std::printf("timeout: tick %llu after waiting again, expected 4\n",static_cast<unsigned long long>(s.get_tick()));
+        ok=false;
+    }
+    return ok;
+}
+
+int main()
+{
+    prefix("");
+    bool ok=true;
+    ok&=check_move();
+    ok&=check_timeout();
+    return ok?0:1;
+}
@@ -0,0 +1,193 @@
+/*
+ * FDX_Tst_sol.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Tst_sol
+    Regression checks of the solver of contacts
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Solver and bodies
+#include "../include/FDX_Sol.hpp"
+
+//Report of the failures
+#include <cstdio>
+
+//Angles of the contacts
+#include <cmath>
+
+using namespace fdx::arrow;
+
+//Length of the steps
+constexpr Vct::Mod DT=0.01;
+
+//Gravity
+constexpr Vct::Mod G=10;
+
+//Check that a value is close to the expected one, returns false and reports it if not
+bool check (const char *name, Vct::Mod got, Vct::Mod expected, Vct::Mod tolerance)
+{
+    if (std::abs(got-expected)<=tolerance)
+        return true;
+    std::printf("%s: got %g, expected %g\n",name,got,expected);
+    return false;
+}
+
+//Ball falling on a static floor, it must bounce with the restitution of its speed and never sink
+bool bounce (Sol::Iteration it)
+{
+    Bdy_store s;
+    s.add(Crl(Vct(0,2),1),Vct(0,-5));
+    s.add(Rct(Vct(-10,-1),Vct(20,1)));
+    Vct::Mod inv_mass[2]={1,0};
+    std::uint32_t a=0, b=1;
+    Sol sol(0.5,0,8,it);
+
+    //Steps until the speed turns up
+    for (int step=0;step<100;step++)
+    {
+        Vct::Mod v=s.speed_y()[0];
+        sol.clear();
+        sol.add(s,&a,&b,1,DT);
+        sol.solve(s,inv_mass,DT);
+        s.integrate(DT);
+        if (s.pos_y()[0]<1-1e-9)
+            return check("bounce position",s.pos_y()[0],1,1e-9);
+        if (s.speed_y()[0]>0)
+            return check("bounce speed",s.speed_y()[0],-0.5*v,1e-9);
+    }
+    std::printf("bounce: the ball never bounced\n");
+    return false;
+}
+
+//Box sliding on a floor with friction, it must stop after v/(mu*g) seconds and v*v/(2*mu*g) of distance, resting on the floor
+bool slide (Sol::Iteration it)
+{
+    Bdy_store s;
+    s.add(Rct(Vct(0,0),Vct(1,1)),Vct(5,0));
+    s.add(Rct(Vct(-100,-1),Vct(200,1)));
+    Vct::Mod inv_mass[2]={1,0};
+    std::uint32_t a=0, b=1;
+    Sol sol(0,0.5,8,it);
+    for (int step=0;step<200;step++)
+    {
+        s.speed_y()[0]-=G*DT;
+        sol.clear();
+        sol.add(s,&a,&b,1,DT);
+        sol.solve(s,inv_mass,DT);
+        s.integrate(DT);
+    }
+    return check("slide speed",s.speed_x()[0],0,1e-9)&check("slide distance",s.pos_x()[0]-0.5,2.5,0.1)&check("slide height",s.pos_y()[0],0.5,1e-6);
+}
+
+//Head on elastic impact of equal masses, the first step closes the gap and the next one swaps the speeds of the impact
+bool elastic (Sol::Iteration it)
+{
+    Bdy_store s;
+    s.add(Crl(Vct(0,0),1),Vct(1,0));
+    s.add(Crl(Vct(2.005,0),1),Vct(-1,0));
+    Vct::Mod inv_mass[2]={1,1};
+    std::uint32_t a=0, b=1;
+    Sol sol(1,0,8,it);
+    for (int step=0;step<2;step++)
+    {
+        s.speed_x()[0]=1;
+        s.speed_x()[1]=-1;
+        sol.clear();
+        sol.add(s,&a,&b,1,DT);
+        sol.solve(s,inv_mass,DT);
+        s.integrate(DT);
+    }
+    return check("elastic first",s.speed_x()[0],-1,1e-9)&check("elastic second",s.speed_x()[1],1,1e-9);
+}
+
+//Stack of boxes on a floor, it must rest without sinking more than the slop of the push
+bool stack (Sol::Iteration it)
+{
+    constexpr std::uint32_t BOXES=5;
+    Bdy_store s;
+    s.add(Rct(Vct(-100,-1),Vct(200,1)));
+    Vct::Mod inv_mass[BOXES+1]={0};
+    std::uint32_t a[BOXES], b[BOXES];
+    for (std::uint32_t i=1;i<=BOXES;i++)
+    {
+        s.add(Rct(Vct(0,i-1.0),Vct(1,1)));
+        inv_mass[i]=1;
+        a[i-1]=i;
+        b[i-1]=i-1;
+    }
+    Sol sol(0,0.5,10,it);
+    for (int step=0;step<300;step++)
+    {
+        for (std::uint32_t i=1;i<=BOXES;i++)
+            s.speed_y()[i]-=G*DT;
+        sol.clear();
+        sol.add(s,a,b,BOXES,DT);
+        sol.solve(s,inv_mass,DT);
+        s.integrate(DT);
+    }
+    return check("stack top",s.pos_y()[BOXES],BOXES-0.5,0.025);
+}
+
+//Circle overlapping the end of a static capsule, the push must follow the real overlap at any angle of the end
+bool capsule_end (Vct::Mod angle)
+{
+    constexpr Vct::Mod DEPTH=1e-4;
+    Vct dir(std::cos(angle),std::sin(angle));
+    Bdy_store s;
+    s.add(Crl(Vct(2,0)+dir*(1.5-DEPTH),1));
+    s.add(Cap(Vct(-2,0),Vct(2,0),0.5));
+    Vct::Mod inv_mass[2]={1,0};
+    std::uint32_t a=0, b=1;
+    Sol sol;
+    sol.clear();
+    sol.add(s,&a,&b,1,DT);
+    sol.solve(s,inv_mass,DT);
+    Vct v(s.speed_x()[0],s.speed_y()[0]);
+    return check("capsule end push",v.mod(),sol.get_push()*DEPTH/DT,1e-6);
+}
+
+int main()
+{
+    bool ok=true;
+    for (Sol::Iteration it : {Sol::Iteration::sequential,Sol::Iteration::jacobi})
+    {
+        ok&=bounce(it);
+        ok&=slide(it);
+        ok&=elastic(it);
+        ok&=stack(it);
+    }
+    for (Vct::Mod deg : {0,30,60,80})
+        ok&=capsule_end(deg*3.14159265358979/180);
+    return ok?0:1;
+}
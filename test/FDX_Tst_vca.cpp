@@ -0,0 +1,70 @@
+/*
+ * FDX_Tst_vca.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Tst_vca
+    Regression checks of the access to the arrays of vectors
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//Arrays of vectors
+#include "../include/FDX_Vca.hpp"
+
+//Report of the failures
+#include <cstdio>
+
+using namespace fdx::arrow;
+
+int main()
+{
+    bool ok=true;
+
+    //A literal index gets a single vector (it used to be ambiguous with the bulk copy)
+    Vca v(std::vector<Vct>{Vct(1,2),Vct(3,4)});
+    if (!(v.get(0)==Vct(1,2)))
+    {
+        std::printf("get(0): got (%g,%g)\n",v.get(0).x,v.get(0).y);
+        ok=false;
+    }
+
+    //The bulk copy writes every vector
+    Vct out[2];
+    v.copy_to(out);
+    if (!(out[0]==Vct(1,2)&&out[1]==Vct(3,4)))
+    {
+        std::printf("copy_to: got (%g,%g) (%g,%g)\n",out[0].x,out[0].y,out[1].x,out[1].y);
+        ok=false;
+    }
+
+    return ok?0:1;
+}
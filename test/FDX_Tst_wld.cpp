@@ -0,0 +1,120 @@
+/*
+ * FDX_Tst_wld.cpp
+ *
+ * Copyright 2015 Joaqu�n Monteagudo G�mez <kindos7@gmail.com>
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ *
+ */
+
+/*
+    C++ library (source file)
+    FDX_Tst_wld
+    Readers of the snapshots of a world while the writer publishes
+*/
+
+/*
+    Version 0.1 (dd/mm/yy, 29/06/2015 -> )
+*/
+
+/*
+    Preprocessor
+*/
+
+/* Includes */
+
+//World
+#include "../include/FDX_Wld.hpp"
+
+//Report of the failures
+#include <cstdio>
+
+//Readers
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace fdx::arrow;
+
+//Number of readers
+constexpr int READERS=4;
+
+//Number of publishes
+constexpr int PUBLISHES=3000;
+
+//Number of bodies, in a row along x
+constexpr int BODIES=500;
+
+/*Readers check that every snapshot is whole while the writer moves every body up by 1 and publishes
+  Built with FDX_ARROW_TSAN it checks that the snapshots are handed over without races*/
+bool readers()
+{
+    Wld w;
+    std::vector<Bdy_hdl> h;
+    for (int i=0;i<BODIES;i++)
+        h.push_back(w.edit().add(Crl(Vct(i*3.0,0),1)));
+    w.publish();
+
+    std::atomic<bool> stop(false);
+    std::atomic<long> reads(0), torn(0), missed(0), nested(0);
+    std::vector<std::thread> rd;
+    for (int t=0;t<READERS;t++)
+        rd.emplace_back([&w,&stop,&reads,&torn,&missed,&nested]
+        {
+            while (!stop.load())
+            {
+                Wld::View v=w.read();
+                const Bdy_store &b=v->get_bodies();
+
+                //Every body of a snapshot has the same height
+                Vct::Coord y=b.pos_y()[0];
+                for (std::size_t i=0;i<b.size();i++)
+                    torn+=b.pos_y()[i]!=y;
+
+                //The circle touches the bodies at x 27, 30 and 33
+                int c=0;
+                v->overlap(Crl(Vct(30,y),2.5),[&c](Bdy_hdl){c++;return true;});
+                missed+=c!=3;
+
+                //A nested view on the same thread takes another slot and never reads an older snapshot
+                Wld::View n=w.read();
+                nested+=n->get_version()<v->get_version();
+                reads++;
+            }
+        });
+    for (int p=0;p<PUBLISHES;p++)
+    {
+        for (Bdy_hdl x : h)
+            w.edit().set_pos_center(x,w.edit().get_pos_center(x)+Vct(0,1));
+        w.publish();
+    }
+    stop=true;
+    for (std::thread &t : rd)
+        t.join();
+
+    //Without readers every replaced snapshot can be reclaimed (the world publishes an empty snapshot when it is built)
+    w.publish();
+    bool ok=!torn&&!missed&&!nested&&!w.pending()&&w.read()->get_version()==PUBLISHES+2;
+    if (!ok)
+        std::printf("readers: %ld reads, %ld torn, %ld missed, %ld nested older, %zu pending\n",reads.load(),torn.load(),missed.load(),nested.load(),w.pending());
+    return ok;
+}
+
+int main()
+{
+    return readers()?0:1;
+}